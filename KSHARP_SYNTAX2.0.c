@@ -2,13 +2,14 @@
 #include <stdlib.h>   /* for general utilities                          */
 #include <string.h>   /* for strlen (only), no strcmp/strncmp/strstr    */
 #include <ctype.h>    /* for isspace, etc.                              */
+#include "ksharp_tokens.h" /* TokenType and the .ktok token stream      */
 
 /* --------------------------------------------------------------------
    LIMITS: maximum sizes for arrays and strings
+   (the token stream itself has no limit, see push_token)
    -------------------------------------------------------------------- */
-#define MAX_LEXEME  128     /* maximum length of a lexeme string        */
-#define MAX_TOKENS  2000    /* maximum number of tokens in stream       */
 #define MAX_LINE    512     /* maximum length of a line from the file   */
+#define MAX_ERRORS  100     /* default --max-errors (0 = no limit)      */
 
 /* --------------------------------------------------------------------
    Custom string helpers (NO strcmp / strncmp / strstr)
@@ -81,70 +82,762 @@ typedef enum {
 } ParserTokKind;
 
 /* --------------------------------------------------------------------
-   One token for the parser: kind + lexeme text
+   One token for the parser: kind + symbol id + lexeme text
+   The grammar decides on kind and sym only; the text is for the tree
+   and the messages. It is not owned by the token: it points into the
+   loaded .ktok file, into g_names, or at a string literal. This is how
+   a pull source (below) hands over a token; the stream keeps the
+   three fields in separate arrays.
    -------------------------------------------------------------------- */
 typedef struct {
     ParserTokKind kind;                 /* category of the token        */
-    char lexeme[MAX_LEXEME];           /* text of the token            */
+    KtokSym sym;                        /* exact symbol/keyword, or none */
+    const char *lexeme;                 /* text of the token, '\0'-ended */
 } ParserToken;
 
 /* --------------------------------------------------------------------
-   Global token stream (simple array)
+   Global token stream (growable arrays, one per field)
+   Token i is g_tok_kind[i], g_tok_sym[i] and g_tok_text[i]. Deciding
+   and skipping only reads the two byte arrays, so a scan such as
+   panic_recover() touches 2 bytes per token instead of a whole
+   ParserToken, and can test eight tokens at once.
    -------------------------------------------------------------------- */
-static ParserToken g_tokens[MAX_TOKENS];  /* array of tokens             */
+static uint8_t     *g_tok_kind = NULL;    /* ParserTokKind of each token */
+static uint8_t     *g_tok_sym = NULL;     /* KtokSym of each token       */
+static const char **g_tok_text = NULL;    /* text of each token          */
 static int g_tok_count = 0;               /* how many tokens are loaded  */
+static int g_tok_cap = 0;                 /* how many fit in the arrays  */
 static int g_tok_index = 0;               /* index of current token      */
 
+#define PT_TOK_SLOT (2 + sizeof(const char *))  /* bytes per token        */
+
+static KshIntern g_names;                /* table texts, each one once  */
+static KtokFile g_ktok;                   /* loaded .ktok: texts in place */
+
+/* push_token:
+   Appends a token, doubling the arrays when they are full.
+   Returns 0 (and prints why) if there is no memory left.              */
+static int push_token(ParserTokKind kind, KtokSym sym, const char *lexeme) {
+    if (g_tok_count == g_tok_cap) {
+        int cap = g_tok_cap ? g_tok_cap * 2 : 1024;
+        uint8_t *k = (uint8_t *)realloc(g_tok_kind, (size_t)cap);
+        uint8_t *s = k ? (uint8_t *)realloc(g_tok_sym, (size_t)cap) : NULL;
+        const char **t = s ? (const char **)realloc((void *)g_tok_text,
+                                                  (size_t)cap * sizeof(const char *))
+                           : NULL;
+        if (k) g_tok_kind = k;            /* a grown array stays, even  */
+        if (s) g_tok_sym = s;             /* if a later one failed     */
+        if (!t) {
+            fprintf(stderr, "[Syntax] Out of memory after %d tokens\n",
+                    g_tok_count);
+            return 0;
+        }
+        ksh_stats_mem((size_t)g_tok_cap * PT_TOK_SLOT, (size_t)cap * PT_TOK_SLOT);
+        g_tok_text = t;
+        g_tok_cap = cap;
+    }
+    g_tok_kind[g_tok_count] = (uint8_t)kind;
+    g_tok_sym[g_tok_count] = (uint8_t)sym;
+    g_tok_text[g_tok_count] = lexeme;
+    g_tok_count++;
+    return 1;
+}
+
+/* free_tokens:
+   Releases the token arrays and every text they point to.             */
+static void free_tokens(void) {
+    ksh_stats_mem((size_t)g_tok_cap * PT_TOK_SLOT, 0);
+    free(g_tok_kind);
+    free(g_tok_sym);
+    free((void *)g_tok_text);
+    g_tok_kind = g_tok_sym = NULL;
+    g_tok_text = NULL;
+    g_tok_count = g_tok_cap = g_tok_index = 0;
+    ksh_intern_free(&g_names);
+    ktok_free(&g_ktok);
+}
+
+/* array_room:
+   Makes room for need more elements of size sz in *p (cap elements,
+   used taken), doubling. Returns 0 if out of memory.                   */
+static int array_room(void **p, size_t *cap, size_t used, size_t need,
+                      size_t sz) {
+    size_t c = *cap ? *cap : 1024;
+    void *q;
+    if (used + need <= *cap)
+        return 1;
+    while (c < used + need)
+        c *= 2;
+    q = realloc(*p, c * sz);
+    if (!q)
+        return 0;
+    ksh_stats_mem(*cap * sz, c * sz);
+    *p = q;
+    *cap = c;
+    return 1;
+}
+
+/* --------------------------------------------------------------------
+   Pull source (used instead of the loaded tokens when set)
+   A driver that runs the lexer in the same process hands the parser a
+   callback; the parser then asks for one token at a time, when it moves
+   past the last one it has. Pulled tokens are kept in the arrays like
+   loaded ones, because the syntax tree refers to them by index.
+   -------------------------------------------------------------------- */
+typedef int (*TokenPull)(void *ctx, ParserToken *out); /* 0 = no more  */
+
+static TokenPull g_pull = NULL;            /* NULL = use loaded tokens   */
+static void     *g_pull_ctx = NULL;        /* passed back to g_pull      */
+
+/* --------------------------------------------------------------------
+   Syntax tree
+   The parse functions build the tree; printing it is a separate walk
+   (see ast_walk and the XML printer below), so drivers can run other
+   passes over it.
+   Nodes come from g_ast_pool and never move. A node refers to its
+   token by index in the token arrays (leaves: the token itself, constructs:
+   their first token): no text is copied.
+   -------------------------------------------------------------------- */
+typedef enum {
+    /* constructs (have children)                                      */
+    AST_PROGRAM,        AST_STATEMENTS,
+    AST_DECL_STMT,      AST_INPUT_STMT,     AST_PRINT_STMT,
+    AST_ASSIGN_STMT,    AST_ASSIGN_UPDATE,
+    AST_IF_STMT,        AST_WHILE_STMT,     AST_FOR_STMT,
+    AST_FOR_INIT,       AST_FOR_COND,       AST_FOR_UPDATE,
+    AST_EXPRESSION,     AST_REL_EXPR,       AST_SIMPLE_EXPR,
+    AST_TERM,
+    /* leaves (one token each)                                         */
+    AST_TYPE,           AST_IDENTIFIER,     AST_KEYWORD,
+    AST_SYMBOL,         AST_LITERAL,
+    /* a statement that did not parse (no token, no children)          */
+    AST_BAD_STMT,
+    /* a ** chain (a construct too; last so .kast kinds stay the same)  */
+    AST_POWER
+} AstKind;
+
+typedef struct AstNode {
+    AstKind kind;                       /* what the node is             */
+    int tok;                            /* index of its token           */
+    struct AstNode *child;              /* first child, or NULL         */
+    struct AstNode *next;               /* next sibling, or NULL        */
+} AstNode;
+
+/* ast_is_leaf:
+   1 for the node kinds that stand for one token.                       */
+static int ast_is_leaf(AstKind k) {
+    return k >= AST_TYPE && k <= AST_LITERAL;
+}
+
+/* ast_is_stmt:
+   1 for the node kinds parse_statement produces.                       */
+static int ast_is_stmt(AstKind k) {
+    return (k >= AST_DECL_STMT && k <= AST_ASSIGN_STMT) ||
+           (k >= AST_IF_STMT && k <= AST_FOR_STMT) ||
+           k == AST_BAD_STMT;
+}
+
+/* ast_tag:
+   Tag name of a node kind in the XML output.                           */
+static const char *ast_tag(AstKind k) {
+    switch (k) {
+        case AST_PROGRAM:       return "program";
+        case AST_STATEMENTS:    return "statements";
+        case AST_DECL_STMT:     return "declStatement";
+        case AST_INPUT_STMT:    return "inputStatement";
+        case AST_PRINT_STMT:    return "printStatement";
+        case AST_ASSIGN_STMT:   return "assignStatement";
+        case AST_ASSIGN_UPDATE: return "assignUpdate";
+        case AST_IF_STMT:       return "ifStatement";
+        case AST_WHILE_STMT:    return "whileStatement";
+        case AST_FOR_STMT:      return "forStatement";
+        case AST_FOR_INIT:      return "forInit";
+        case AST_FOR_COND:      return "forCondition";
+        case AST_FOR_UPDATE:    return "forUpdate";
+        case AST_EXPRESSION:    return "expression";
+        case AST_REL_EXPR:      return "relExpression";
+        case AST_SIMPLE_EXPR:   return "simpleExpression";
+        case AST_TERM:          return "term";
+        case AST_TYPE:          return "type";
+        case AST_IDENTIFIER:    return "identifier";
+        case AST_KEYWORD:       return "keyword";
+        case AST_SYMBOL:        return "symbol";
+        case AST_LITERAL:       return "literal";
+        case AST_BAD_STMT:      return "badStatement";
+        case AST_POWER:         return "power";
+    }
+    return "?";
+}
+
+/* Tree under construction: the open constructs, innermost last, each
+   with its last child so far (appending is O(1)).                      */
+typedef struct {
+    AstNode *node;                      /* the open construct           */
+    AstNode *tail;                      /* its last child, or NULL      */
+} AstOpen;
+
+static KshPool  g_ast_pool;               /* all nodes                   */
+static AstNode *g_ast_root = NULL;        /* AST_PROGRAM after a parse   */
+static AstOpen *g_open = NULL;            /* open constructs (a stack)   */
+static int g_open_count = 0;              /* depth                       */
+static int g_open_cap = 0;                /* room in g_open              */
+static int g_ast_oom = 0;                 /* set once memory ran out     */
+
+/* AstWalkAt:
+   One node on the path from the root, and its next child to visit.    */
+typedef struct {
+    const AstNode *node;
+    const AstNode *next;
+} AstWalkAt;
+
+static AstWalkAt *g_walk = NULL;          /* path of ast_walk (a stack)  */
+static size_t     g_walk_cap = 0;
+
+/* ExprFrame:
+   One expression being parsed (see parse_expression): the whole one,
+   or one in ( ).                                                       */
+typedef struct {
+    AstNode *mark;                    /* last node before the operand */
+    unsigned char rel;                /* relop already taken          */
+    unsigned char power;              /* <power> open                 */
+} ExprFrame;
+
+static ExprFrame *g_expr = NULL;      /* g_expr[0]: outermost         */
+static size_t g_expr_cap = 0;
+
+/* ast_oom:
+   Remembers (and reports, once) that the tree is incomplete.          */
+static void ast_oom(void) {
+    if (!g_ast_oom)
+        fprintf(stderr, "[Syntax] Out of memory building the syntax tree\n");
+    g_ast_oom = 1;
+}
+
+/* ast_add:
+   Appends a new node to the innermost open construct (or makes it the
+   root). Returns NULL once out of memory.                              */
+static AstNode *ast_add(AstKind kind, int tok) {
+    AstNode *n;
+    if (g_ast_oom)
+        return NULL;
+    n = (AstNode *)ksh_pool_alloc(&g_ast_pool, sizeof(AstNode));
+    if (!n) {
+        ast_oom();
+        return NULL;
+    }
+    n->kind = kind;
+    n->tok = tok;
+    n->child = n->next = NULL;
+    KSH_STAT(ksh_stats.nodes++);
+
+    if (g_open_count == 0) {              /* first node: the root      */
+        g_ast_root = n;
+    } else {
+        AstOpen *o = &g_open[g_open_count - 1];
+        if (o->tail) o->tail->next = n;
+        else         o->node->child = n;
+        o->tail = n;
+    }
+    return n;
+}
+
+/* ast_open:
+   Starts a construct at the current token; the nodes added until the
+   matching ast_close become its children.                              */
+static void ast_open(AstKind kind) {
+    AstNode *n = ast_add(kind, g_tok_index);
+    if (g_open_count == g_open_cap && !g_ast_oom) {
+        int cap = g_open_cap ? g_open_cap * 2 : 64;
+        AstOpen *p = (AstOpen *)realloc(g_open, (size_t)cap * sizeof(AstOpen));
+        if (p) {
+            ksh_stats_mem((size_t)g_open_cap * sizeof(AstOpen),
+                          (size_t)cap * sizeof(AstOpen));
+            g_open = p;
+            g_open_cap = cap;
+        } else {
+            ast_oom();
+        }
+    }
+    if (!g_ast_oom) {                     /* else only keep the depth  */
+        g_open[g_open_count].node = n;
+        g_open[g_open_count].tail = NULL;
+    }
+    g_open_count++;
+}
+
+/* ast_close:
+   Ends the innermost construct.                                        */
+static void ast_close(void) {
+    g_open_count--;
+}
+
+/* ast_leaf:
+   Adds a leaf for the current token.                                   */
+static void ast_leaf(AstKind kind) {
+    ast_add(kind, g_tok_index);
+}
+
+/* ast_last:
+   The last child of the innermost open construct so far, or NULL.      */
+static AstNode *ast_last(void) {
+    if (g_ast_oom || g_open_count == 0)
+        return NULL;
+    return g_open[g_open_count - 1].tail;
+}
+
+/* ast_wrap:
+   Like ast_open, but the children of the innermost construct that came
+   after `after` (all of them if NULL) move into the new construct
+   first. For an operator that is only seen after its left operand.    */
+static void ast_wrap(AstKind kind, AstNode *after) {
+    AstOpen *o = g_ast_oom ? NULL : &g_open[g_open_count - 1];
+    AstNode *first = o ? (after ? after->next : o->node->child) : NULL;
+    AstNode *last = o ? o->tail : NULL;
+    AstNode *n;
+
+    ast_open(kind);                       /* n goes in after `last`    */
+    if (g_ast_oom || !first)
+        return;
+    o = &g_open[g_open_count - 2];        /* g_open may have moved     */
+    n = g_open[g_open_count - 1].node;
+    if (after) after->next = n;
+    else       o->node->child = n;
+    last->next = NULL;
+    n->child = first;
+    n->tok = first->tok;                  /* starts where they started */
+    g_open[g_open_count - 1].tail = last;
+}
+
+/* ast_reset:
+   Forgets the tree but keeps the memory for the next one.              */
+static void ast_reset(void) {
+    ksh_pool_reset(&g_ast_pool);
+    g_open_count = 0;
+    g_ast_root = NULL;
+    g_ast_oom = 0;
+}
+
+/* ast_free:
+   Drops the whole tree.                                                */
+static void ast_free(void) {
+    ksh_pool_free(&g_ast_pool);
+    ksh_stats_mem((size_t)g_open_cap * sizeof(AstOpen), 0);
+    ksh_stats_mem(g_walk_cap * sizeof(AstWalkAt), 0);
+    ksh_stats_mem(g_expr_cap * sizeof(ExprFrame), 0);
+    free(g_open);
+    free(g_walk);
+    free(g_expr);
+    g_walk = NULL;
+    g_expr = NULL;
+    g_walk_cap = g_expr_cap = 0;
+    g_open = NULL;
+    g_open_count = g_open_cap = 0;
+    g_ast_root = NULL;
+    g_ast_oom = 0;
+}
+
+/* --------------------------------------------------------------------
+   Tree walk
+   enter is called on a node before its children, leave after them;
+   parent is NULL for the root.
+   -------------------------------------------------------------------- */
+typedef struct {
+    void (*enter)(void *ctx, const AstNode *n, const AstNode *parent);
+    void (*leave)(void *ctx, const AstNode *n, const AstNode *parent);
+    void *ctx;
+} AstVisitor;
+
+/* ast_walk:
+   Visits n and everything under it. The path is kept in g_walk, not on
+   the C stack, so a tree of any depth can be walked. Returns 0 if out
+   of memory (the walk stops there).                                    */
+static int ast_walk(const AstNode *n, const AstNode *parent,
+                    const AstVisitor *v) {
+    size_t depth = 0;
+    if (v->enter) v->enter(v->ctx, n, parent);
+    if (!array_room((void **)&g_walk, &g_walk_cap, 0, 1, sizeof(AstWalkAt)))
+        return 0;
+    g_walk[depth].node = n;
+    g_walk[depth++].next = n->child;
+    while (depth) {
+        AstWalkAt *at = &g_walk[depth - 1];
+        const AstNode *c = at->next;
+        if (!c) {                         /* all children done         */
+            const AstNode *up = depth > 1 ? g_walk[depth - 2].node : parent;
+            if (v->leave) v->leave(v->ctx, at->node, up);
+            depth--;
+            continue;
+        }
+        at->next = c->next;
+        if (v->enter) v->enter(v->ctx, c, at->node);
+        if (!array_room((void **)&g_walk, &g_walk_cap, depth, 1, sizeof(AstWalkAt)))
+            return 0;
+        g_walk[depth].node = c;
+        g_walk[depth++].next = c->child;
+    }
+    return 1;
+}
+
 /* --------------------------------------------------------------------
-   Pretty-printer helpers (for XML-like parse tree)
+   Tree output (one visitor per format)
+   TREE_XML   the XML-like parse tree on stdout (default; a driver can
+              point g_out somewhere else)
+   TREE_JSON  the same tree as JSON, in SyntaxTree.json
+   TREE_BIN   the binary form (see .kast in ksharp_tokens.h), in
+              SyntaxTree.kast
+   TREE_NONE  nothing: only diagnostics and the verdict (--no-tree)
+   Text formats go through an OutBuf, so a tree costs a handful of
+   fwrite calls instead of several printf calls per node.
    -------------------------------------------------------------------- */
-static int g_indent = 0;                  /* current indentation depth   */
+typedef enum { TREE_XML, TREE_JSON, TREE_BIN, TREE_NONE } TreeFormat;
+
+static TreeFormat g_tree_format = TREE_XML;  /* chosen by tree_option */
+static FILE *g_out = NULL;      /* XML tree and verdict; NULL = stdout */
+
+#define TREE_JSON_FILE "SyntaxTree.json"
+#define OUT_BUF_SIZE   (64 * 1024)          /* bytes per fwrite       */
+
+typedef struct {
+    FILE  *fp;                          /* where the bytes go           */
+    size_t used;                        /* bytes waiting in buf         */
+    int    failed;                      /* set if an fwrite fell short  */
+    char   buf[OUT_BUF_SIZE];
+} OutBuf;
+
+/* out_flush:
+   Writes out whatever is buffered.                                     */
+static void out_flush(OutBuf *o) {
+    if (o->used && fwrite(o->buf, 1, o->used, o->fp) != o->used)
+        o->failed = 1;
+    o->used = 0;
+}
+
+/* out_put:
+   Appends n bytes, flushing as often as needed.                        */
+static void out_put(OutBuf *o, const char *s, size_t n) {
+    while (n > 0) {
+        size_t room = OUT_BUF_SIZE - o->used;
+        if (room == 0) {
+            out_flush(o);
+            room = OUT_BUF_SIZE;
+        }
+        if (room > n) room = n;
+        memcpy(o->buf + o->used, s, room);
+        o->used += room;
+        s += room;
+        n -= room;
+    }
+}
+
+static void out_str(OutBuf *o, const char *s) {
+    out_put(o, s, strlen(s));
+}
+
+/* out_indent:
+   Two spaces per level, copied from a constant string of spaces.       */
+static void out_indent(OutBuf *o, int depth) {
+    static const char spaces[] =
+        "                                                                "
+        "                                                                ";
+    size_t n = (size_t)depth * 2;
+    while (n > 0) {
+        size_t k = n < sizeof(spaces) - 1 ? n : sizeof(spaces) - 1;
+        out_put(o, spaces, k);
+        n -= k;
+    }
+}
 
-/* print_indent:
-   Prints two spaces for each indent level.                              */
-static void print_indent(void) {
-    for (int i = 0; i < g_indent; ++i) {  /* repeat for each indent     */
-        printf("  ");                     /* two spaces                 */
+/* ---- XML ------------------------------------------------------------ */
+
+typedef struct {
+    OutBuf *out;
+    int indent;                         /* current indentation depth    */
+} XmlCtx;
+
+/* xml_enter:
+   Constructs: opening tag, one level deeper. Leaves: the whole
+   <tag> text </tag> line.                                              */
+static void xml_enter(void *ctx, const AstNode *n, const AstNode *parent) {
+    XmlCtx *x = (XmlCtx *)ctx;
+    const char *tag = ast_tag(n->kind);
+    (void)parent;
+    if (n->kind == AST_BAD_STMT)          /* nothing to show            */
+        return;
+    if (ast_is_leaf(n->kind)) {
+        out_indent(x->out, x->indent);
+        out_put(x->out, "<", 1);  out_str(x->out, tag);
+        out_put(x->out, "> ", 2); out_str(x->out, g_tok_text[n->tok]);
+        out_put(x->out, " </", 3); out_str(x->out, tag);
+        out_put(x->out, ">\n", 2);
+        return;
     }
+    out_put(x->out, "\n", 1);  /* visual separator before a new construct */
+    out_indent(x->out, x->indent);
+    out_put(x->out, "<", 1); out_str(x->out, tag); out_put(x->out, ">\n", 2);
+    x->indent++;
 }
 
-/* open_tag:
-   Prints an opening XML-like tag and increases indent.                  */
-static void open_tag(const char *name) {
-    printf("\n");              /* NEW: visual separator before a new construct */
-    print_indent();            
-    printf("<%s>\n", name);    
-    g_indent++;                
+/* xml_leave:
+   Closing tag of a construct; statements of a list or block are also
+   followed by an empty line.                                           */
+static void xml_leave(void *ctx, const AstNode *n, const AstNode *parent) {
+    XmlCtx *x = (XmlCtx *)ctx;
+    if (n->kind != AST_BAD_STMT && !ast_is_leaf(n->kind)) {
+        x->indent--;
+        out_indent(x->out, x->indent);
+        out_put(x->out, "</", 2); out_str(x->out, ast_tag(n->kind));
+        out_put(x->out, ">\n\n", 3);  /* blank line after a construct  */
+    }
+    if (ast_is_stmt(n->kind) && parent && parent->kind != AST_FOR_INIT)
+        out_put(x->out, "\n", 1);  /* visual separator between statements */
 }
 
-/* close_tag:
-   Prints a closing XML-like tag and decreases indent.                   */
-static void close_tag(const char *name) {
-    g_indent--;                           
-    print_indent();                       
-    printf("</%s>\n", name);              
-    printf("\n");              /* NEW: blank line after closing a construct */
+/* ---- JSON ----------------------------------------------------------- */
+
+/* json_string:
+   Writes s as a JSON string literal.                                   */
+static void json_string(OutBuf *o, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    const char *run = s;                  /* bytes that need no escape  */
+    out_put(o, "\"", 1);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        out_put(o, run, (size_t)(s - run));
+        if (c == '"')       out_put(o, "\\\"", 2);
+        else if (c == '\\') out_put(o, "\\\\", 2);
+        else if (c == '\n') out_put(o, "\\n", 2);
+        else if (c == '\t') out_put(o, "\\t", 2);
+        else {
+            char u[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+            out_put(o, u, 6);
+        }
+        run = s + 1;
+    }
+    out_put(o, run, (size_t)(s - run));
+    out_put(o, "\"", 1);
 }
 
+/* json_enter / json_leave:
+   {"type":"...","text":"..."} for leaves,
+   {"type":"...","children":[...]} for constructs.                      */
+static void json_enter(void *ctx, const AstNode *n, const AstNode *parent) {
+    OutBuf *o = (OutBuf *)ctx;
+    if (parent && parent->child != n)     /* not the first sibling      */
+        out_put(o, ",", 1);
+    out_put(o, "{\"type\":", 8);
+    json_string(o, ast_tag(n->kind));
+    if (ast_is_leaf(n->kind)) {
+        out_put(o, ",\"text\":", 8);
+        json_string(o, g_tok_text[n->tok]);
+    } else if (n->kind != AST_BAD_STMT) {
+        out_put(o, ",\"children\":[", 13);
+    }
+}
 
-/* leaf_tag:
-   Prints <tag> text </tag> on one line (no nested children).            */
-static void leaf_tag(const char *name, const char *text) {
-    print_indent();                       /* indent                     */
-    printf("<%s> %s </%s>\n", name, text, name); /* one-line element     */
+static void json_leave(void *ctx, const AstNode *n, const AstNode *parent) {
+    OutBuf *o = (OutBuf *)ctx;
+    (void)parent;
+    if (ast_is_leaf(n->kind) || n->kind == AST_BAD_STMT)
+        out_put(o, "}", 1);
+    else
+        out_put(o, "]}", 2);
+}
+
+/* ---- binary (.kast) -------------------------------------------------- */
+
+typedef struct {
+    KastNode *node;                     /* records, in preorder         */
+    size_t    count, cap;
+    char     *blob;                     /* leaf texts, '\0'-ended       */
+    size_t    used, blob_cap;
+    int       oom;                      /* set if a realloc failed      */
+} KastOut;
+
+/* kast_release:
+   Frees the records and texts of k.                                   */
+static void kast_release(KastOut *k) {
+    ksh_stats_mem(k->cap * sizeof(KastNode), 0);
+    ksh_stats_mem(k->blob_cap, 0);
+    free(k->node);
+    free(k->blob);
+}
+
+/* kast_enter:
+   One record per node; children come right after their parent.      */
+static void kast_enter(void *ctx, const AstNode *n, const AstNode *parent) {
+    KastOut *k = (KastOut *)ctx;
+    const AstNode *c;
+    KastNode *r;
+    (void)parent;
+    if (k->oom || !array_room((void **)&k->node, &k->cap, k->count, 1,
+                             sizeof(KastNode))) {
+        k->oom = 1;
+        return;
+    }
+    r = &k->node[k->count++];
+    memset(r, 0, sizeof(*r));
+    r->kind = (uint8_t)n->kind;
+    for (c = n->child; c; c = c->next)
+        r->nchild++;
+    if (ast_is_leaf(n->kind)) {
+        const char *text = g_tok_text[n->tok];
+        size_t len = strlen(text);
+        if (!array_room((void **)&k->blob, &k->blob_cap, k->used, len + 1, 1)) {
+            k->oom = 1;
+            return;
+        }
+        r->sym = g_tok_sym[n->tok];
+        r->off = (uint32_t)k->used;
+        r->len = (uint32_t)len;
+        memcpy(k->blob + k->used, text, len + 1);
+        k->used += len + 1;
+    }
+}
+
+/* write_tree_bin:
+   Writes the tree as a .kast file. Returns 0 on failure.              */
+static int write_tree_bin(const AstNode *root, const char *path) {
+    KastOut k;
+    KastHeader h;
+    AstVisitor v = { kast_enter, NULL, NULL };
+    FILE *fp;
+    int ok;
+
+    memset(&k, 0, sizeof(k));
+    v.ctx = &k;
+    if (!ast_walk(root, NULL, &v))
+        k.oom = 1;
+    if (k.oom || k.count > 0xFFFFFFFFu || k.used > 0xFFFFFFFFu) {
+        kast_release(&k);
+        return 0;
+    }
+
+    memcpy(h.magic, "KAST", 4);
+    h.version = KAST_VERSION;
+    h.count = (uint32_t)k.count;
+    h.blob_size = (uint32_t)k.used;
+
+    fp = fopen(path, "wb");
+    ok = fp &&
+         fwrite(&h, sizeof(h), 1, fp) == 1 &&
+         fwrite(k.node, sizeof(KastNode), k.count, fp) == k.count &&
+         (k.used == 0 || fwrite(k.blob, 1, k.used, fp) == k.used);
+    if (fp && fclose(fp) != 0)
+        ok = 0;
+    kast_release(&k);
+    return ok;
+}
+
+/* ---- front end ------------------------------------------------------- */
+
+/* write_tree_text:
+   Walks the tree with v into a buffered file. Returns 0 on failure.   */
+static int write_tree_text(const AstNode *root, FILE *fp, AstVisitor *v,
+                           OutBuf *o, const char *end) {
+    o->fp = fp;
+    o->used = 0;
+    o->failed = 0;
+    if (!ast_walk(root, NULL, v))
+        o->failed = 1;
+    out_str(o, end);
+    out_flush(o);
+    return !o->failed && fflush(fp) == 0;
+}
+
+/* emit_tree:
+   Writes the tree in g_tree_format. Returns 0 (and says why) if the
+   output could not be written.                                        */
+static int emit_tree(const AstNode *root) {
+    static OutBuf out;                    /* 64 KB, not on the stack    */
+    int ok = 1;
+
+    switch (g_tree_format) {
+    case TREE_NONE:
+        return 1;
+
+    case TREE_XML: {
+        XmlCtx x;
+        AstVisitor v = { xml_enter, xml_leave, NULL };
+        x.out = &out;
+        x.indent = 0;
+        v.ctx = &x;
+        ok = write_tree_text(root, g_out ? g_out : stdout, &v, &out, "");
+        if (!ok) fprintf(stderr, "[Syntax] Cannot write the tree to stdout\n");
+        return ok;
+    }
+
+    case TREE_JSON: {
+        AstVisitor v = { json_enter, json_leave, NULL };
+        FILE *fp = fopen(TREE_JSON_FILE, "wb");
+        v.ctx = &out;
+        ok = fp && write_tree_text(root, fp, &v, &out, "\n");
+        if (fp && fclose(fp) != 0)
+            ok = 0;
+        if (!ok) fprintf(stderr, "[Syntax] Cannot write %s\n", TREE_JSON_FILE);
+        return ok;
+    }
+
+    case TREE_BIN:
+        ok = write_tree_bin(root, KAST_FILE);
+        if (!ok) fprintf(stderr, "[Syntax] Cannot write %s\n", KAST_FILE);
+        return ok;
+    }
+    return 1;
+}
+
+/* tree_option:
+   Handles --no-tree and --tree=xml|json|bin. Returns 1 if arg was one
+   of them, 0 if it is something else, -1 for an unknown format.       */
+static int tree_option(const char *arg) {
+    if (str_eq(arg, "--no-tree"))  { g_tree_format = TREE_NONE; return 1; }
+    if (!str_starts_with(arg, "--tree="))
+        return 0;
+    arg += 7;
+    if (str_eq(arg, "xml"))        { g_tree_format = TREE_XML;  return 1; }
+    if (str_eq(arg, "json"))       { g_tree_format = TREE_JSON; return 1; }
+    if (str_eq(arg, "bin"))        { g_tree_format = TREE_BIN;  return 1; }
+    return -1;
 }
 
 /* --------------------------------------------------------------------
    Current token helpers
    -------------------------------------------------------------------- */
 
-/* cur_tok:
-   Returns pointer to current token.                                     */
-static ParserToken *cur_tok(void) {
+/* set_eof:
+   Turns t into the EOF token, with the same "EOF" text the loaders use. */
+static void set_eof(ParserToken *t) {
+    t->kind = PT_EOF;                     /* mark as EOF                */
+    t->sym = KSYM_NONE;                   /* not a symbol               */
+    t->lexeme = "EOF";                    /* store "EOF" text           */
+}
+
+/* tok_set_eof:
+   set_eof() for token i of the stream.                                  */
+static void tok_set_eof(int i) {
+    g_tok_kind[i] = PT_EOF;
+    g_tok_sym[i] = KSYM_NONE;
+    g_tok_text[i] = "EOF";
+}
+
+/* cur_at:
+   Index of the current token.                                           */
+static int cur_at(void) {
     if (g_tok_index >= g_tok_count) {     /* if past last token         */
-        return &g_tokens[g_tok_count - 1];/* return last (EOF) token    */
+        return g_tok_count - 1;           /* the last (EOF) token       */
     }
-    return &g_tokens[g_tok_index];        /* otherwise current token    */
+    return g_tok_index;                   /* otherwise current token    */
+}
+
+/* cur_kind / cur_sym:
+   Kind and symbol id of the current token.                              */
+static ParserTokKind cur_kind(void) {
+    return (ParserTokKind)g_tok_kind[cur_at()];
+}
+
+static KtokSym cur_sym(void) {
+    return (KtokSym)g_tok_sym[cur_at()];
 }
 
 /* next_tok:
@@ -152,9 +845,37 @@ static ParserToken *cur_tok(void) {
 static void next_tok(void) {
     if (g_tok_index < g_tok_count - 1) {  /* ensure not beyond last     */
         g_tok_index++;                    /* advance index              */
+        return;
+    }
+    if (g_pull && g_tok_kind[g_tok_count - 1] != PT_EOF) {
+        ParserToken t;                    /* streaming from the lexer   */
+        if (!g_pull(g_pull_ctx, &t))
+            set_eof(&t);                  /* source ran dry             */
+        if (push_token(t.kind, t.sym, t.lexeme))
+            g_tok_index++;
+        else                              /* out of memory: stop here   */
+            tok_set_eof(g_tok_count - 1);
     }
 }
 
+#ifdef KSHARP_NO_MAIN                     /* only drivers set a source  */
+/* parser_set_source:
+   Makes cur_kind()/next_tok() and the rest pull tokens from fn(ctx) instead of the
+   loaded array, and reads the first token. fn must end with a PT_EOF
+   token (or return 0, which counts as EOF). Returns 0 if out of memory.
+   Token texts must stay valid as long as the tokens (and the tree).    */
+static int parser_set_source(TokenPull fn, void *ctx) {
+    ParserToken t;
+    g_pull = fn;
+    g_pull_ctx = ctx;
+    g_tok_count = 0;                      /* one slot: the current token */
+    g_tok_index = 0;
+    if (!fn(ctx, &t))                     /* empty source => EOF        */
+        set_eof(&t);
+    return push_token(t.kind, t.sym, t.lexeme);
+}
+#endif
+
 /* --------------------------------------------------------------------
    trim:
    Removes leading and trailing whitespace from string s in-place.
@@ -262,30 +983,104 @@ static int load_tokens_from_symbol_table(const char *path) {
 
         ParserTokKind pk = map_kind(rawKind); /* map kind string       */
 
-        if (g_tok_count < MAX_TOKENS) {       /* prevent overflow       */
-            ParserToken *pt = &g_tokens[g_tok_count++]; /* next slot    */
-            pt->kind = pk;                     /* store token kind      */
-
-            /* copy lexeme into token struct safely                    */
-            int i = 0;
-            while (rawLex[i] != '\0' && i < MAX_LEXEME - 1) {
-                pt->lexeme[i] = rawLex[i];
-                i++;
+        /* --stats counts by TokenType: the table only has the labels,
+           so a whole "operator" or "punctuator" group goes to its
+           first kind                                                   */
+        for (unsigned t = 0; t < TOK_KIND_COUNT; t++)
+            if (str_eq(rawKind, ktok_type_name(t))) {
+                KSH_STAT(ksh_stats.tokens[t]++);
+                break;
             }
-            pt->lexeme[i] = '\0';             /* terminate string       */
+
+        /* the table has no symbol ids: look them up once, here        */
+        KtokSym sym = KSYM_NONE;
+        if (pk == PT_KEYWORD || pk == PT_OPERATOR || pk == PT_SYMBOL)
+            sym = (KtokSym)ksym_lookup(rawLex);
+
+        /* one copy of every distinct lexeme                           */
+        const char *lex = ksh_intern_str(&g_names, rawLex, strlen(rawLex));
+        if (!lex || !push_token(pk, sym, lex)) {
+            fclose(fp);
+            return 0;                  /* out of memory               */
         }
     }
 
     fclose(fp);                        /* close the file              */
 
     /* If last token is not EOF, append EOF token at the end.          */
-    if (g_tok_count == 0 || g_tokens[g_tok_count - 1].kind != PT_EOF) {
-        ParserToken *pt = &g_tokens[g_tok_count++]; /* new token        */
-        pt->kind = PT_EOF;                      /* mark as EOF          */
-        pt->lexeme[0] = 'E';                   /* store "EOF" text      */
-        pt->lexeme[1] = 'O';
-        pt->lexeme[2] = 'F';
-        pt->lexeme[3] = '\0';
+    if (g_tok_count == 0 || g_tok_kind[g_tok_count - 1] != PT_EOF) {
+        if (!push_token(PT_EOF, KSYM_NONE, "EOF"))         /* new EOF token        */
+            return 0;
+    }
+
+    return g_tok_count;                /* return number of tokens     */
+}
+
+/* --------------------------------------------------------------------
+   map_type:
+   Converts a lexer TokenType (from the .ktok stream) to a
+   ParserTokKind. Same mapping as map_kind on the table labels.
+   -------------------------------------------------------------------- */
+static ParserTokKind map_type(unsigned type) {
+    switch (type) {
+        case TOK_KEYWORD:       return PT_KEYWORD;
+        case TOK_IDENTIFIER:    return PT_IDENTIFIER;
+        case TOK_RESERVED_TYPE: return PT_TYPE;
+        case TOK_CONST_INT:     return PT_INTCONST;
+        case TOK_CONST_FLOAT:   return PT_FLOATCONST;
+        case TOK_CONST_CHAR:    return PT_CHARCONST;
+        case TOK_CONST_BOOL:    return PT_BOOLCONST;
+        case TOK_OP_ARITH:                        /* all four are       */
+        case TOK_OP_REL:                          /* "operator" in the  */
+        case TOK_OP_LOGIC:                        /* table              */
+        case TOK_ASSIGN:        return PT_OPERATOR;
+        case TOK_DELIM:                           /* both "punctuator"  */
+        case TOK_BRACKET:       return PT_SYMBOL;
+        case TOK_COMMENT:       return PT_COMMENT;
+        case TOK_NOISE:         return PT_NOISE;
+        case TOK_EOF:           return PT_EOF;
+        default:                return PT_UNKNOWN; /* strings, unknown  */
+    }
+}
+
+/* --------------------------------------------------------------------
+   load_tokens_from_ktok:
+   Reads tokens from the binary stream written by the lexer
+   (SymbolTable.ktok, one read for the whole file). Unlike the text
+   table, lexemes are not clipped and the TokenType is exact. The file
+   stays loaded (g_ktok) and tokens point into it.
+   Returns the number of tokens, or 0 if the file is missing or bad
+   (the caller then falls back to SymbolTable.txt).
+   -------------------------------------------------------------------- */
+static int load_tokens_from_ktok(const char *path) {
+    KtokFile *f = &g_ktok;            /* whole file in one buffer     */
+    int rc = ktok_load(path, f);
+    uint32_t r;
+
+    if (rc == 0)                      /* no .ktok: silent fallback    */
+        return 0;
+    if (rc < 0) {                     /* stale or damaged file        */
+        fprintf(stderr, "[Syntax] Ignoring invalid token file: %s\n", path);
+        return 0;
+    }
+
+    g_tok_count = 0;                  /* reset token counter          */
+
+    /* texts stay in the file buffer: tokens point straight at them    */
+    for (r = 0; r < f->count; r++) {
+        if (f->rec[r].type < TOK_KIND_COUNT)  /* counted for --stats    */
+            KSH_STAT(ksh_stats.tokens[f->rec[r].type]++);
+        if (f->rec[r].type == TOK_EOF)        /* appended below, as for */
+            break;                            /* the text table         */
+        if (!push_token(map_type(f->rec[r].type),
+                        (KtokSym)f->rec[r].sym, ktok_text(f, r)))
+            return 0;
+    }
+
+    /* If last token is not EOF, append EOF token at the end.          */
+    if (g_tok_count == 0 || g_tok_kind[g_tok_count - 1] != PT_EOF) {
+        if (!push_token(PT_EOF, KSYM_NONE, "EOF"))         /* new EOF token        */
+            return 0;
     }
 
     return g_tok_count;                /* return number of tokens     */
@@ -293,18 +1088,204 @@ static int load_tokens_from_symbol_table(const char *path) {
 
 /* --------------------------------------------------------------------
    Error handling and panic recovery
+   Every message has a code; the text is SYNTAX_MSG[code]. Errors are
+   kept in g_diag (the token they were found at and the code) and
+   printed together by flush_diagnostics() when the run ends, so a file
+   with thousands of errors costs one buffered write, not one per line.
+   After g_max_errors errors the parser jumps to EOF: the rest of the
+   file is not looked at.
    -------------------------------------------------------------------- */
+typedef enum {
+    SE_STMT_START,                     /* statement cannot start here */
+    SE_DECL_IDENT,
+    SE_DECL_SEMI,
+    SE_INPUT_IDENT,
+    SE_INPUT_SEMI,
+    SE_PRINT_SEMI,
+    SE_ASSIGN_IDENT,
+    SE_ASSIGN_EQ,
+    SE_ASSIGN_SEMI,
+    SE_UPDATE_IDENT,
+    SE_UPDATE_EQ,
+    SE_BLOCK_RBRACE,
+    SE_IF_LPAREN,
+    SE_IF_RPAREN,
+    SE_WHILE_LPAREN,
+    SE_WHILE_RPAREN,
+    SE_FOR_LPAREN,
+    SE_FOR_SEMI,
+    SE_FOR_RPAREN,
+    SE_GROUP_RPAREN,
+    SE_PRIMARY,                        /* no operand in an expression */
+    SE_EXTRA_CODE,                     /* tokens after the program    */
+    SE_COUNT
+} SyntaxCode;
+
+static const char *const SYNTAX_MSG[SE_COUNT] = {
+    "Unexpected token at start of statement",
+    "Expected identifier after type",
+    "Missing ';' after declaration",
+    "Expected identifier after 'input'",
+    "Missing ';' after input statement",
+    "Missing ';' after print statement",
+    "Expected identifier at start of assignment",
+    "Expected '=' in assignment",
+    "Missing ';' after assignment",
+    "Expected identifier in for-update",
+    "Expected '=' in for-update",
+    "Missing '}' at end of block",
+    "Expected '(' after 'if'",
+    "Expected ')' after condition",
+    "Expected '(' after 'while'",
+    "Expected ')' after while condition",
+    "Expected '(' after 'for'",
+    "Missing ';' in for condition",
+    "Expected ')' after for header",
+    "Missing ')' after grouped expression",
+    "Expected identifier, literal, or '(' in expression",
+    "Unexpected extra code after program"
+};
+
+typedef struct {
+    int tok;                           /* index of the token          */
+    SyntaxCode code;                   /* what was wrong              */
+} SyntaxDiag;
+
 static int g_error = 0;                /* flag: set if any error      */
+static int g_error_count = 0;          /* errors in this run          */
+static int g_max_errors = 0;           /* stop after this many, 0=never */
+static int g_stopped = 0;              /* g_max_errors was reached    */
+
+static SyntaxDiag *g_diag = NULL;      /* errors not yet printed      */
+static size_t g_diag_count = 0;
+static size_t g_diag_cap = 0;
+
+/* A driver that keeps the diagnostics itself (see ksharp_incremental.c)
+   sets g_error_hook: it then gets each message (always a string
+   literal) and the index of the token it was found at, and nothing is
+   collected or printed.                                                */
+typedef void (*SyntaxErrorHook)(void *ctx, const char *msg, int tok);
+
+static SyntaxErrorHook g_error_hook = NULL;
+static void *g_error_ctx = NULL;       /* passed back to g_error_hook */
+
+/* stop_parse:
+   Makes EOF the current token, so every parse function winds down.
+   With a pull source the rest is not read (the driver may drain it). */
+static void stop_parse(void) {
+    if (g_tok_kind[g_tok_count - 1] != PT_EOF &&
+        !push_token(PT_EOF, KSYM_NONE, "EOF"))
+        tok_set_eof(g_tok_count - 1);
+    g_tok_index = g_tok_count - 1;
+    g_stopped = 1;
+}
 
 /* syntax_error:
-   Prints a message and sets g_error to 1.                              */
-static void syntax_error(const char *msg) {
-    ParserToken *t = cur_tok();        /* current token               */
-    fprintf(stderr,
-            "[Syntax Error] %s. Near: %s\n",
-            msg,
-            t->lexeme[0] ? t->lexeme : "(EOF)");
+   Records an error at the current token and sets g_error to 1. Errors
+   met while winding down after --max-errors are dropped.               */
+static void syntax_error(SyntaxCode code) {
+    int tok = cur_at();                /* current token               */
     g_error = 1;                       /* remember there was an error */
+    if (g_stopped)
+        return;
+    KSH_STAT(ksh_stats.errors++);
+    g_error_count++;
+    if (g_error_hook) {
+        g_error_hook(g_error_ctx, SYNTAX_MSG[code], tok);
+    } else if (array_room((void **)&g_diag, &g_diag_cap, g_diag_count, 1,
+                         sizeof(SyntaxDiag))) {
+        g_diag[g_diag_count].tok = tok;
+        g_diag[g_diag_count].code = code;
+        g_diag_count++;
+    }                                  /* out of memory: not kept     */
+    if (g_max_errors && g_error_count >= g_max_errors)
+        stop_parse();
+}
+
+/* diag_put:
+   Appends n bytes to the buffer of flush_diagnostics.                 */
+static void diag_put(char *buf, size_t *used, size_t size,
+                     const char *s, size_t n) {
+    while (n) {
+        size_t k = size - *used < n ? size - *used : n;
+        memcpy(buf + *used, s, k);
+        *used += k;
+        s += k;
+        n -= k;
+        if (*used == size) {
+            fwrite(buf, 1, *used, stderr);
+            *used = 0;
+        }
+    }
+}
+
+/* flush_diagnostics:
+   Prints the collected errors to stderr, one line each, and frees the
+   list. The lines are gathered in a buffer: stderr has none.          */
+static void flush_diagnostics(void) {
+    char buf[1 << 14];
+    size_t used = 0;
+    for (size_t i = 0; i < g_diag_count; i++) {
+        const char *msg = SYNTAX_MSG[g_diag[i].code];
+        const char *near = g_tok_text[g_diag[i].tok];
+        if (!near[0])
+            near = "(EOF)";
+        diag_put(buf, &used, sizeof(buf), "[Syntax Error] ", 15);
+        diag_put(buf, &used, sizeof(buf), msg, strlen(msg));
+        diag_put(buf, &used, sizeof(buf), ". Near: ", 8);
+        diag_put(buf, &used, sizeof(buf), near, strlen(near));
+        diag_put(buf, &used, sizeof(buf), "\n", 1);
+    }
+    if (used)
+        fwrite(buf, 1, used, stderr);
+    ksh_stats_mem(g_diag_cap * sizeof(SyntaxDiag), 0);
+    free(g_diag);
+    g_diag = NULL;
+    g_diag_count = g_diag_cap = 0;
+    if (g_stopped && !g_error_hook)
+        fprintf(stderr, "[Syntax] Stopped after %d errors (--max-errors).\n",
+                g_error_count);
+}
+
+/* max_errors_option:
+   Handles --max-errors=N (0 = no limit). Returns 1 if arg was it, 0 if
+   it is something else, -1 if N is not a number.                      */
+static int max_errors_option(const char *arg) {
+    char *end;
+    long n;
+    if (!str_starts_with(arg, "--max-errors="))
+        return 0;
+    n = strtol(arg + 13, &end, 10);
+    if (end == arg + 13 || *end || n < 0 || n > 1000000000L)
+        return -1;
+    g_max_errors = (int)n;
+    return 1;
+}
+
+/* find_boundary:
+   Index of the first token in [from, to) that is ';', '}' or EOF, or
+   to if there is none. Eight tokens at a time: a byte of
+   (sym ^ KSYM_SEMI) etc. is zero exactly where a token matches, and
+   HAS_ZERO_BYTE tells whether any of the eight is.                      */
+#define BYTES8(b) (0x0101010101010101ull * (uint64_t)(b))
+#define HAS_ZERO_BYTE(v) (((v) - BYTES8(1)) & ~(v) & BYTES8(0x80))
+
+static int find_boundary(int from, int to) {
+    int i = from;
+    for (; i + 8 <= to; i += 8) {
+        uint64_t s, k;
+        memcpy(&s, g_tok_sym + i, 8);
+        memcpy(&k, g_tok_kind + i, 8);
+        if (HAS_ZERO_BYTE(s ^ BYTES8(KSYM_SEMI)) |
+            HAS_ZERO_BYTE(s ^ BYTES8(KSYM_RBRACE)) |
+            HAS_ZERO_BYTE(k ^ BYTES8(PT_EOF)))
+            break;                       /* one of these eight        */
+    }
+    for (; i < to; i++)
+        if (g_tok_sym[i] == KSYM_SEMI || g_tok_sym[i] == KSYM_RBRACE ||
+            g_tok_kind[i] == PT_EOF)
+            return i;
+    return to;
 }
 
 /* panic_recover:
@@ -314,29 +1295,41 @@ static void syntax_error(const char *msg) {
    - end-of-file
    This allows the parser to continue after an error.                   */
 static void panic_recover(void) {
-    while (cur_tok()->kind != PT_EOF) {  /* loop until EOF            */
-        if (cur_tok()->kind == PT_SYMBOL) { /* if symbol token        */
-            if (str_eq(cur_tok()->lexeme, ";") ||
-                str_eq(cur_tok()->lexeme, "}")) {
+    KSH_STAT(ksh_stats.recoveries++);
+    for (;;) {
+        int last = g_tok_count - 1;
+        int i = find_boundary(cur_at(), g_tok_count);
+        if (i <= last) {                 /* found among the tokens    */
+            g_tok_index = i;
+            if (g_tok_kind[i] != PT_EOF)
                 next_tok();              /* consume boundary          */
-                break;                   /* exit panic mode           */
-            }
+            return;                      /* exit panic mode           */
         }
-        next_tok();                      /* skip this token           */
+        g_tok_index = last;              /* pull source: read on      */
+        next_tok();
+        if (g_tok_index == last && g_tok_kind[last] != PT_EOF)
+            return;                      /* cannot move (no source)   */
     }
 }
 
 /* --------------------------------------------------------------------
    Helpers for matching specific symbols like ";" or ")"
+   A symbol id is only ever set on a token of that exact kind and text,
+   so comparing ids is the whole test.
    -------------------------------------------------------------------- */
 
+/* is_sym:
+   1 if the current token is the given symbol or keyword.               */
+static int is_sym(KtokSym sym) {
+    return cur_sym() == sym;
+}
+
 /* accept_symbol:
    If current token is the given symbol, consume it and print leaf tag.
    Returns 1 on success, 0 otherwise.                                   */
-static int accept_symbol(const char *sym) {
-    if (cur_tok()->kind == PT_SYMBOL &&
-        str_eq(cur_tok()->lexeme, sym)) {
-        leaf_tag("symbol", cur_tok()->lexeme); /* print symbol node   */
+static int accept_symbol(KtokSym sym) {
+    if (is_sym(sym)) {
+        ast_leaf(AST_SYMBOL);                   /* symbol node         */
         next_tok();                             /* move to next token  */
         return 1;                               /* success             */
     }
@@ -345,9 +1338,9 @@ static int accept_symbol(const char *sym) {
 
 /* expect_symbol:
    Calls accept_symbol; if it fails, reports an error and recovers.     */
-static void expect_symbol(const char *sym, const char *errmsg) {
+static void expect_symbol(KtokSym sym, SyntaxCode code) {
     if (!accept_symbol(sym)) {          /* if symbol not present       */
-        syntax_error(errmsg);           /* report specific error       */
+        syntax_error(code);             /* report specific error       */
         panic_recover();                /* skip ahead to safe point    */
     }
 }
@@ -368,9 +1361,6 @@ static void parse_while_stmt(void);
 static void parse_for_stmt(void);
 static void parse_block(void);
 static void parse_expression(void);
-static void parse_simple_expr(void);
-static void parse_term(void);
-static void parse_factor(void);
 
 /* --------------------------------------------------------------------
    Grammar: program → stmt_list EOF
@@ -379,65 +1369,59 @@ static void parse_factor(void);
 /* parse_program:
    Entry point of the parser.                                           */
 static void parse_program(void) {
-    open_tag("program");            /* <program>                      */
+    ast_open(AST_PROGRAM);          /* <program>                      */
     parse_stmt_list();              /* parse list of statements       */
-    close_tag("program");           /* </program>                     */
+    ast_close();                    /* </program>                     */
 }
 
 /* parse_stmt_list:
    stmt_list → { statement }                                           */
 static void parse_stmt_list(void) {
-    while (cur_tok()->kind != PT_EOF) {    /* until EOF token         */
+    while (cur_kind() != PT_EOF) {    /* until EOF token         */
         parse_statement();                 /* parse one statement      */
-        printf("\n");   /* visual separator between statements */
-
     }
 }
 
 /* parse_statement:
    Decides which kind of statement to parse based on current token.     */
 static void parse_statement(void) {
-    ParserToken *t = cur_tok();           /* inspect current token     */
-
     /* Declaration: starts with type token                             */
-    if (t->kind == PT_TYPE) {
+    if (cur_kind() == PT_TYPE) {          /* inspect current token     */
         parse_decl_stmt();
         return;
     }
 
     /* Keyword-based statements                                        */
-    if (t->kind == PT_KEYWORD) {
-        if (str_eq(t->lexeme, "input")) {
+    switch (cur_sym()) {
+        case KSYM_INPUT:
             parse_input_stmt();
             return;
-        }
-        if (str_eq(t->lexeme, "print") ||
-            str_eq(t->lexeme, "writeln")) {
+        case KSYM_PRINT:
+        case KSYM_WRITELN:
             parse_print_stmt();
             return;
-        }
-        if (str_eq(t->lexeme, "if")) {
+        case KSYM_IF:
             parse_if_stmt();
             return;
-        }
-        if (str_eq(t->lexeme, "while")) {
+        case KSYM_WHILE:
             parse_while_stmt();
             return;
-        }
-        if (str_eq(t->lexeme, "for")) {
+        case KSYM_FOR:
             parse_for_stmt();
             return;
-        }
+        default:
+            break;
     }
 
     /* Assignment: begins with identifier                              */
-    if (t->kind == PT_IDENTIFIER) {
+    if (cur_kind() == PT_IDENTIFIER) {
         parse_assign_stmt();
         return;
     }
 
     /* If none of the above matched, it is an unexpected token.        */
-    syntax_error("Unexpected token at start of statement");
+    ast_add(AST_BAD_STMT, g_tok_index);   /* keeps its place in the tree */
+    syntax_error(SE_STMT_START);
     panic_recover();
 }
 
@@ -446,69 +1430,69 @@ static void parse_statement(void) {
    Example:                int x;
    -------------------------------------------------------------------- */
 static void parse_decl_stmt(void) {
-    open_tag("declStatement");          /* <declStatement>            */
+    ast_open(AST_DECL_STMT);            /* <declStatement>            */
 
     /* type token already verified by caller                           */
-    leaf_tag("type", cur_tok()->lexeme);/* tag for the type           */
+    ast_leaf(AST_TYPE);                 /* tag for the type           */
     next_tok();                         /* consume type               */
 
     /* expect identifier name                                          */
-    if (cur_tok()->kind == PT_IDENTIFIER) {
-        leaf_tag("identifier", cur_tok()->lexeme);
+    if (cur_kind() == PT_IDENTIFIER) {
+        ast_leaf(AST_IDENTIFIER);
         next_tok();
     } else {
-        syntax_error("Expected identifier after type");
+        syntax_error(SE_DECL_IDENT);
     }
 
     /* expect semicolon to end declaration                             */
-    expect_symbol(";", "Missing ';' after declaration");
+    expect_symbol(KSYM_SEMI, SE_DECL_SEMI);
 
-    close_tag("declStatement");         /* </declStatement>           */
+    ast_close();                        /* </declStatement>           */
 }
 
 /* --------------------------------------------------------------------
    Input statement: input identifier ;
    -------------------------------------------------------------------- */
 static void parse_input_stmt(void) {
-    open_tag("inputStatement");         /* <inputStatement>           */
+    ast_open(AST_INPUT_STMT);           /* <inputStatement>           */
 
     /* keyword 'input'                                                 */
-    leaf_tag("keyword", cur_tok()->lexeme);
+    ast_leaf(AST_KEYWORD);
     next_tok();
 
     /* identifier to store input                                       */
-    if (cur_tok()->kind == PT_IDENTIFIER) {
-        leaf_tag("identifier", cur_tok()->lexeme);
+    if (cur_kind() == PT_IDENTIFIER) {
+        ast_leaf(AST_IDENTIFIER);
         next_tok();
     } else {
-        syntax_error("Expected identifier after 'input'");
+        syntax_error(SE_INPUT_IDENT);
     }
 
     /* semicolon terminator                                            */
-    expect_symbol(";", "Missing ';' after input statement");
+    expect_symbol(KSYM_SEMI, SE_INPUT_SEMI);
 
-    close_tag("inputStatement");        /* </inputStatement>          */
+    ast_close();                        /* </inputStatement>          */
 }
 
 /* --------------------------------------------------------------------
    Print / writeln statement:  print expression ;
    -------------------------------------------------------------------- */
 static void parse_print_stmt(void) {
-    open_tag("printStatement");         /* <printStatement>           */
+    ast_open(AST_PRINT_STMT);           /* <printStatement>           */
 
     /* keyword print or writeln                                        */
-    leaf_tag("keyword", cur_tok()->lexeme);
+    ast_leaf(AST_KEYWORD);
     next_tok();
 
     /* parse expression to be printed                                  */
-    open_tag("expression");
+    ast_open(AST_EXPRESSION);
     parse_expression();
-    close_tag("expression");
+    ast_close();
 
     /* ending semicolon                                                */
-    expect_symbol(";", "Missing ';' after print statement");
+    expect_symbol(KSYM_SEMI, SE_PRINT_SEMI);
 
-    close_tag("printStatement");        /* </printStatement>          */
+    ast_close();                        /* </printStatement>          */
 }
 
 /* --------------------------------------------------------------------
@@ -517,34 +1501,33 @@ static void parse_print_stmt(void) {
    Used for normal statements and for-init in for-loop.
    -------------------------------------------------------------------- */
 static void parse_assign_stmt(void) {
-    open_tag("assignStatement");        /* <assignStatement>          */
+    ast_open(AST_ASSIGN_STMT);          /* <assignStatement>          */
 
     /* left-hand side identifier                                      */
-    if (cur_tok()->kind == PT_IDENTIFIER) {
-        leaf_tag("identifier", cur_tok()->lexeme);
+    if (cur_kind() == PT_IDENTIFIER) {
+        ast_leaf(AST_IDENTIFIER);
         next_tok();
     } else {
-        syntax_error("Expected identifier at start of assignment");
+        syntax_error(SE_ASSIGN_IDENT);
     }
 
     /* assignment operator '='                                         */
-    if (cur_tok()->kind == PT_OPERATOR &&
-        str_eq(cur_tok()->lexeme, "=")) {
-        leaf_tag("symbol", "=");
+    if (is_sym(KSYM_ASSIGN)) {
+        ast_leaf(AST_SYMBOL);
         next_tok();
     } else {
-        syntax_error("Expected '=' in assignment");
+        syntax_error(SE_ASSIGN_EQ);
     }
 
     /* right-hand side expression                                      */
-    open_tag("expression");
+    ast_open(AST_EXPRESSION);
     parse_expression();
-    close_tag("expression");
+    ast_close();
 
     /* semicolon required                                              */
-    expect_symbol(";", "Missing ';' after assignment");
+    expect_symbol(KSYM_SEMI, SE_ASSIGN_SEMI);
 
-    close_tag("assignStatement");       /* </assignStatement>         */
+    ast_close();                        /* </assignStatement>         */
 }
 
 /* --------------------------------------------------------------------
@@ -554,35 +1537,34 @@ static void parse_assign_stmt(void) {
    (NO semicolon here; ')' terminates the header)
    -------------------------------------------------------------------- */
 static void parse_assign_no_semicolon(void) {
-    open_tag("assignUpdate");           /* <assignUpdate>             */
+    ast_open(AST_ASSIGN_UPDATE);        /* <assignUpdate>             */
 
     /* left-hand side identifier                                      */
-    if (cur_tok()->kind == PT_IDENTIFIER) {
-        leaf_tag("identifier", cur_tok()->lexeme);
+    if (cur_kind() == PT_IDENTIFIER) {
+        ast_leaf(AST_IDENTIFIER);
         next_tok();
     } else {
-        syntax_error("Expected identifier in for-update");
-        close_tag("assignUpdate");
+        syntax_error(SE_UPDATE_IDENT);
+        ast_close();
         return;
     }
 
     /* '=' operator                                                    */
-    if (cur_tok()->kind == PT_OPERATOR &&
-        str_eq(cur_tok()->lexeme, "=")) {
-        leaf_tag("symbol", "=");
+    if (is_sym(KSYM_ASSIGN)) {
+        ast_leaf(AST_SYMBOL);
         next_tok();
     } else {
-        syntax_error("Expected '=' in for-update");
-        close_tag("assignUpdate");
+        syntax_error(SE_UPDATE_EQ);
+        ast_close();
         return;
     }
 
     /* expression on right side                                       */
-    open_tag("expression");
+    ast_open(AST_EXPRESSION);
     parse_expression();
-    close_tag("expression");
+    ast_close();
 
-    close_tag("assignUpdate");          /* </assignUpdate>            */
+    ast_close();                        /* </assignUpdate>            */
 }
 
 /* --------------------------------------------------------------------
@@ -590,27 +1572,23 @@ static void parse_assign_no_semicolon(void) {
    -------------------------------------------------------------------- */
 static void parse_block(void) {
     /* if block starts with '{', parse multiple statements             */
-    if (cur_tok()->kind == PT_SYMBOL &&
-        str_eq(cur_tok()->lexeme, "{")) {
+    if (is_sym(KSYM_LBRACE)) {
 
-        leaf_tag("symbol", "{");       /* print opening brace         */
+        ast_leaf(AST_SYMBOL);          /* print opening brace         */
         next_tok();                    /* consume '{'                 */
 
-        open_tag("statements");        /* <statements>                */
-        while (cur_tok()->kind != PT_EOF &&
-               !(cur_tok()->kind == PT_SYMBOL &&
-                 str_eq(cur_tok()->lexeme, "}"))) {
+        ast_open(AST_STATEMENTS);      /* <statements>                */
+        while (cur_kind() != PT_EOF &&
+               !is_sym(KSYM_RBRACE)) {
             parse_statement();         /* parse each inner statement  */
-            printf("\n");   /* visual separator between statements */
         }
-        close_tag("statements");       /* </statements>               */
+        ast_close();                   /* </statements>               */
 
         /* require closing '}'                                         */
-        expect_symbol("}", "Missing '}' at end of block");
+        expect_symbol(KSYM_RBRACE, SE_BLOCK_RBRACE);
     } else {
         /* otherwise a single statement acts as the block              */
         parse_statement();
-        printf("\n");   /* visual separator between statements */
     }
 }
 
@@ -619,35 +1597,34 @@ static void parse_block(void) {
       if ( expression ) block [ else block ]
    -------------------------------------------------------------------- */
 static void parse_if_stmt(void) {
-    open_tag("ifStatement");          /* <ifStatement>               */
+    ast_open(AST_IF_STMT);            /* <ifStatement>               */
 
     /* 'if' keyword                                                   */
-    leaf_tag("keyword", cur_tok()->lexeme);
+    ast_leaf(AST_KEYWORD);
     next_tok();
 
     /* opening '(' for condition                                      */
-    expect_symbol("(", "Expected '(' after 'if'");
+    expect_symbol(KSYM_LPAREN, SE_IF_LPAREN);
 
     /* condition expression                                           */
-    open_tag("expression");
+    ast_open(AST_EXPRESSION);
     parse_expression();
-    close_tag("expression");
+    ast_close();
 
     /* closing ')'                                                    */
-    expect_symbol(")", "Expected ')' after condition");
+    expect_symbol(KSYM_RPAREN, SE_IF_RPAREN);
 
     /* parse then-block                                               */
     parse_block();
 
     /* optional else part                                             */
-    if (cur_tok()->kind == PT_KEYWORD &&
-        str_eq(cur_tok()->lexeme, "else")) {
-        leaf_tag("keyword", "else");
+    if (is_sym(KSYM_ELSE)) {
+        ast_leaf(AST_KEYWORD);
         next_tok();
         parse_block();
     }
 
-    close_tag("ifStatement");         /* </ifStatement>              */
+    ast_close();                      /* </ifStatement>              */
 }
 
 /* --------------------------------------------------------------------
@@ -655,27 +1632,27 @@ static void parse_if_stmt(void) {
       while ( expression ) block
    -------------------------------------------------------------------- */
 static void parse_while_stmt(void) {
-    open_tag("whileStatement");       /* <whileStatement>            */
+    ast_open(AST_WHILE_STMT);         /* <whileStatement>            */
 
     /* 'while' keyword                                                */
-    leaf_tag("keyword", cur_tok()->lexeme);
+    ast_leaf(AST_KEYWORD);
     next_tok();
 
     /* '(' for condition                                              */
-    expect_symbol("(", "Expected '(' after 'while'");
+    expect_symbol(KSYM_LPAREN, SE_WHILE_LPAREN);
 
     /* expression for condition                                       */
-    open_tag("expression");
+    ast_open(AST_EXPRESSION);
     parse_expression();
-    close_tag("expression");
+    ast_close();
 
     /* ')' after condition                                            */
-    expect_symbol(")", "Expected ')' after while condition");
+    expect_symbol(KSYM_RPAREN, SE_WHILE_RPAREN);
 
     /* loop body block                                                */
     parse_block();
 
-    close_tag("whileStatement");      /* </whileStatement>           */
+    ast_close();                      /* </whileStatement>           */
 }
 
 /* --------------------------------------------------------------------
@@ -685,40 +1662,40 @@ static void parse_while_stmt(void) {
       for (i = 0; i < 5; i = i + 1) { ... }
    -------------------------------------------------------------------- */
 static void parse_for_stmt(void) {
-    open_tag("forStatement");         /* <forStatement>              */
+    ast_open(AST_FOR_STMT);           /* <forStatement>              */
 
     /* 'for' keyword                                                  */
-    leaf_tag("keyword", cur_tok()->lexeme);
+    ast_leaf(AST_KEYWORD);
     next_tok();
 
     /* opening '('                                                    */
-    expect_symbol("(", "Expected '(' after 'for'");
+    expect_symbol(KSYM_LPAREN, SE_FOR_LPAREN);
 
     /* --- for-init: full assignment with semicolon ----------------- */
-    open_tag("forInit");
+    ast_open(AST_FOR_INIT);
     parse_assign_stmt();              /* consumes trailing ';'       */
-    close_tag("forInit");
+    ast_close();
 
     /* --- for-condition --------------------------------------------- */
-    open_tag("forCondition");
+    ast_open(AST_FOR_COND);
     parse_expression();               /* reads condition expression  */
-    close_tag("forCondition");
+    ast_close();
 
     /* semicolon after condition                                     */
-    expect_symbol(";", "Missing ';' in for condition");
+    expect_symbol(KSYM_SEMI, SE_FOR_SEMI);
 
     /* --- for-update: assignment without semicolon ------------------ */
-    open_tag("forUpdate");
+    ast_open(AST_FOR_UPDATE);
     parse_assign_no_semicolon();      /* no ';' inside header        */
-    close_tag("forUpdate");
+    ast_close();
 
     /* closing ')' of for header                                     */
-    expect_symbol(")", "Expected ')' after for header");
+    expect_symbol(KSYM_RPAREN, SE_FOR_RPAREN);
 
     /* loop body block                                               */
     parse_block();
 
-    close_tag("forStatement");        /* </forStatement>             */
+    ast_close();                      /* </forStatement>             */
 }
 
 /* --------------------------------------------------------------------
@@ -726,157 +1703,218 @@ static void parse_for_stmt(void) {
 
    expression   → simple_expr [relop simple_expr]
    simple_expr  → term { (+ | - | ||) term }
-   term         → factor { (* | / | % | &&) factor }
-   factor       → identifier | constant | ( expression )
+   term         → power { (* | / | % | div | mod | &&) power }
+   power        → factor { ** factor }        (right to left)
+   factor       → ! factor | identifier | constant | ( expression )
+
+   The rules are not one function each: parse_expression climbs the
+   levels in a loop, with one EXPR_LEVEL lookup per operator, and keeps
+   the open parentheses in g_expr instead of on the C stack, so nesting
+   is only limited by memory. The tree is the one the rules describe; a
+   <power> node is only made for an actual ** chain.
    -------------------------------------------------------------------- */
-
-/* is_relop:
-   Returns 1 if op is a relational operator, 0 otherwise.               */
-static int is_relop(const char *op) {
-    return (str_eq(op, "==") ||
-            str_eq(op, "!=") ||
-            str_eq(op, "<")  ||
-            str_eq(op, "<=") ||
-            str_eq(op, ">")  ||
-            str_eq(op, ">="));
+enum { XL_NONE, XL_REL, XL_ADD, XL_MUL, XL_POW };
+
+static const unsigned char EXPR_LEVEL[KSYM_COUNT] = {
+    [KSYM_EQ]    = XL_REL, [KSYM_NE]    = XL_REL,
+    [KSYM_LT]    = XL_REL, [KSYM_LE]    = XL_REL,
+    [KSYM_GT]    = XL_REL, [KSYM_GE]    = XL_REL,
+    [KSYM_PLUS]  = XL_ADD, [KSYM_MINUS] = XL_ADD, [KSYM_OR]      = XL_ADD,
+    [KSYM_STAR]  = XL_MUL, [KSYM_SLASH] = XL_MUL, [KSYM_PERCENT] = XL_MUL,
+    [KSYM_DIV]   = XL_MUL, [KSYM_MOD]   = XL_MUL, [KSYM_AND]     = XL_MUL,
+    [KSYM_POW]   = XL_POW
+};
+
+/* expr_begin:
+   Opens the levels of an expression in frame f.                        */
+static void expr_begin(ExprFrame *f) {
+    f->rel = f->power = 0;
+    ast_open(AST_REL_EXPR);           /* <relExpression>             */
+    ast_open(AST_SIMPLE_EXPR);        /* <simpleExpression>          */
+    ast_open(AST_TERM);               /* <term>                      */
 }
 
 /* parse_expression:
-   Handles optional relational operator on top of simple_expr.          */
+   expression, as above. Leaves the tokens after it alone.             */
 static void parse_expression(void) {
-    open_tag("relExpression");        /* <relExpression>             */
-
-    parse_simple_expr();              /* parse left side             */
+    size_t top = 0;                   /* g_expr[top]: innermost       */
+    ExprFrame *f;
 
-    /* if current token is a relational operator, parse right side     */
-    if (cur_tok()->kind == PT_OPERATOR &&
-        is_relop(cur_tok()->lexeme)) {
-        leaf_tag("symbol", cur_tok()->lexeme);
-        next_tok();
-        parse_simple_expr();
+    if (!array_room((void **)&g_expr, &g_expr_cap, 0, 1, sizeof(ExprFrame))) {
+        ast_oom();
+        stop_parse();
+        return;
     }
+    expr_begin(&g_expr[0]);
+
+    for (;;) {
+        /* one operand: its '!'s, then the factor                      */
+        ParserTokKind kind;
+        f = &g_expr[top];
+        f->mark = ast_last();
+        while (is_sym(KSYM_NOT)) {
+            ast_leaf(AST_SYMBOL);
+            next_tok();
+        }
+        kind = cur_kind();
+        if (is_sym(KSYM_LPAREN)) {
+            ast_leaf(AST_SYMBOL);
+            next_tok();               /* consume '('                 */
+            if (array_room((void **)&g_expr, &g_expr_cap, top + 1, 1,
+                           sizeof(ExprFrame))) {
+                top++;
+                ast_open(AST_EXPRESSION);
+                expr_begin(&g_expr[top]);
+                continue;             /* its first operand           */
+            }
+            ast_oom();                /* the parse ends here         */
+            stop_parse();
+        } else if (kind == PT_IDENTIFIER) {
+            ast_leaf(AST_IDENTIFIER);
+            next_tok();
+        } else if (kind == PT_INTCONST  ||
+                   kind == PT_FLOATCONST||
+                   kind == PT_CHARCONST ||
+                   kind == PT_BOOLCONST) {
+            ast_leaf(AST_LITERAL);
+            next_tok();
+        } else {
+            syntax_error(SE_PRIMARY);
+            panic_recover();
+        }
 
-    close_tag("relExpression");       /* </relExpression>            */
-}
-
-/* parse_simple_expr:
-   Handles +, -, || chains.                                             */
-static void parse_simple_expr(void) {
-    open_tag("simpleExpression");     /* <simpleExpression>          */
-
-    parse_term();                     /* first term                  */
-
-    /* additional (+ | - | ||) term segments                          */
-    while (cur_tok()->kind == PT_OPERATOR &&
-          (str_eq(cur_tok()->lexeme, "+")  ||
-           str_eq(cur_tok()->lexeme, "-")  ||
-           str_eq(cur_tok()->lexeme, "||"))) {
+        /* operators after it, until one wants another operand; what
+           no level takes ends the innermost expression                */
+        for (;;) {
+            int level = EXPR_LEVEL[cur_sym()];
+            f = &g_expr[top];
+            if (level == XL_POW) {
+                if (!f->power) {      /* the operand goes in <power>  */
+                    ast_wrap(AST_POWER, f->mark);
+                    f->power = 1;
+                }
+            } else if (f->power) {
+                ast_close();          /* </power>                    */
+                f->power = 0;
+            }
+            if (level == XL_POW || level == XL_MUL) {
+                ast_leaf(AST_SYMBOL);
+                next_tok();
+                break;
+            }
+            if (level == XL_ADD) {
+                ast_close();          /* </term>                     */
+                ast_leaf(AST_SYMBOL);
+                next_tok();
+                ast_open(AST_TERM);
+                break;
+            }
+            if (level == XL_REL && !f->rel) {
+                ast_close();          /* </term>                     */
+                ast_close();          /* </simpleExpression>         */
+                ast_leaf(AST_SYMBOL);
+                next_tok();
+                ast_open(AST_SIMPLE_EXPR);
+                ast_open(AST_TERM);
+                f->rel = 1;
+                break;
+            }
 
-        leaf_tag("symbol", cur_tok()->lexeme);
-        next_tok();
-        parse_term();
+            ast_close();              /* </term>                     */
+            ast_close();              /* </simpleExpression>         */
+            ast_close();              /* </relExpression>            */
+            if (top == 0)
+                return;
+            ast_close();              /* </expression>               */
+            if (is_sym(KSYM_RPAREN)) {
+                ast_leaf(AST_SYMBOL);
+                next_tok();           /* consume ')'                 */
+            } else {
+                syntax_error(SE_GROUP_RPAREN);
+            }
+            top--;                    /* ( ) was an operand out here */
+        }
     }
-
-    close_tag("simpleExpression");   
 }
 
-/* parse_term:
-   Handles *, /, %, && chains.                                         */
-static void parse_term(void) {
-    open_tag("term");                 /* <term>                      */
-
-    parse_factor();                   /* first factor                */
-
-    /* additional (* | / | % | &&) factor segments                     */
-    while (cur_tok()->kind == PT_OPERATOR &&
-          (str_eq(cur_tok()->lexeme, "*")  ||
-           str_eq(cur_tok()->lexeme, "/")  ||
-           str_eq(cur_tok()->lexeme, "%")  ||
-           str_eq(cur_tok()->lexeme, "&&"))) {
-
-        leaf_tag("symbol", cur_tok()->lexeme);
-        next_tok();
-        parse_factor();
-    }
+/* --------------------------------------------------------------------
+   syntax_run:
+   Parses the whole token stream (loaded array or pull source) into
+   g_ast_root, writes the tree (see g_tree_format) and prints the
+   verdict. The tree stays until ast_free(). Returns 0 if all went well,
+   1 if there were syntax errors, 2 if the tree could not be written.
+   -------------------------------------------------------------------- */
+static int syntax_run(void) {
+    /* initialize global state                                         */
+    g_tok_index = 0;                      /* start at first token      */
+    g_error = 0;                          /* clear error flag          */
+    g_error_count = 0;
+    g_stopped = 0;
+    ast_reset();                          /* no tree from a last run   */
+    double t = ksh_now();                 /* for --stats               */
 
-    close_tag("term");                /* </term>                     */
-}
+    /* start parsing from program rule                                 */
+    parse_program();
 
-/* parse_factor:
-   factor → identifier | constant | ( expression )
-   -------------------------------------------------------------------- */
-static void parse_factor(void) {
-    ParserToken *t = cur_tok();       /* look at current token       */
-
-    /* Parenthesized expression: ( expression )                        */
-    if (t->kind == PT_SYMBOL && str_eq(t->lexeme, "(")) {
-        leaf_tag("symbol", "(");
-        next_tok();                   /* consume '('                 */
-
-        open_tag("expression");
-        parse_expression();           /* parse inner expression      */
-        close_tag("expression");
-
-        if (cur_tok()->kind == PT_SYMBOL &&
-            str_eq(cur_tok()->lexeme, ")")) {
-            leaf_tag("symbol", ")");
-            next_tok();               /* consume ')'                 */
-        } else {
-            syntax_error("Missing ')' after grouped expression");
-        }
-        return;
+    /* after parse, we expect only EOF                                 */
+    if (cur_kind() != PT_EOF) {
+        syntax_error(SE_EXTRA_CODE);
     }
 
-    /* Identifier as a factor                                          */
-    if (t->kind == PT_IDENTIFIER) {
-        leaf_tag("identifier", t->lexeme);
-        next_tok();
-        return;
-    }
+    t = ksh_stats_lap(&ksh_stats, KSH_PH_PARSE, t);
+    flush_diagnostics();                  /* before the tree, as ever  */
 
-    /* Constant literal as factor                                      */
-    if (t->kind == PT_INTCONST  ||
-        t->kind == PT_FLOATCONST||
-        t->kind == PT_CHARCONST ||
-        t->kind == PT_BOOLCONST) {
+    int written = 1;
+    if (g_ast_oom)                        /* tree incomplete           */
+        g_error = 1;
+    else
+        written = emit_tree(g_ast_root);
+    ksh_stats_lap(&ksh_stats, KSH_PH_WRITE, t);
 
-        leaf_tag("literal", t->lexeme);
-        next_tok();
-        return;
+    if (g_error) {
+        fprintf(g_out ? g_out : stdout, "\n[Syntax] Program has syntax errors.\n");
+    } else {
+        fprintf(g_out ? g_out : stdout, "\n[Syntax] Program is syntactically correct.\n");
     }
 
-    /* If none of the valid options match, it is an error.             */
-    syntax_error("Expected identifier, literal, or '(' in expression");
-    panic_recover();
+    if (!written)
+        return 2;
+    return g_error;
 }
 
+#ifndef KSHARP_NO_MAIN
+int main(int argc, char **argv) {
+    int stats = 0;                        /* --stats: report on stderr */
+    g_max_errors = MAX_ERRORS;
+    for (int a = 1; a < argc; a++) {
+        int r = str_eq(argv[a], "--stats") ? (stats = 1) :
+                max_errors_option(argv[a]);
+        if (r == 0)
+            r = tree_option(argv[a]);
+        if (r <= 0) {
+            fprintf(stderr, "[Syntax] Unknown option: %s\n"
+                    "usage: syntax [--stats] [--max-errors=N]"
+                    " [--no-tree | --tree=xml|json|bin]\n", argv[a]);
+            return 1;
+        }
+    }
 
-int main(void) {
-    int n = load_tokens_from_symbol_table("SymbolTable.txt");
+    double t = ksh_now();
+    int n = load_tokens_from_ktok(KTOK_FILE);    /* binary stream    */
+    if (n == 0)                                   /* else text table  */
+        n = load_tokens_from_symbol_table("SymbolTable.txt");
+    ksh_stats_lap(&ksh_stats, KSH_PH_LOAD, t);
     if (n == 0) {                         /* if no tokens were loaded  */
         fprintf(stderr, "[Syntax] No tokens loaded.\n");
         return 1;                         /* stop with error code      */
     }
 
-    /* initialize global state                                         */
-    g_tok_index = 0;                      /* start at first token      */
-    g_error = 0;                          /* clear error flag          */
-    g_indent = 0;                         /* reset indentation         */
-
-    /* start parsing from program rule                                 */
-    parse_program();
-
-    /* after parse, we expect only EOF                                 */
-    if (cur_tok()->kind != PT_EOF) {
-        syntax_error("Unexpected extra code after program");
-    }
-
-   
-    if (g_error) {
-        printf("\n[Syntax] Program has syntax errors.\n");
-    } else {
-        printf("\n[Syntax] Program is syntactically correct.\n");
-    }
+    int rc = syntax_run();
+    if (stats)
+        ksh_stats_print(stderr);
 
-    return 0;                            
+    ast_free();
+    free_tokens();
+    return rc == 2;          /* syntax errors are not a failure of the tool */
 }
+#endif /* KSHARP_NO_MAIN */
@@ -0,0 +1,351 @@
+/* ksharp_bench.c
+   Times the three stages on their own: how fast the lexer, the parser
+   and the semantic checker get through a file.
+
+   Usage:  ksharp_bench [--runs=N] [--stages=lex,parse,check] [--csv=FILE]
+                        file.ksh...
+     --runs    timed runs per stage (default 5), after one untimed run
+     --stages  which stages to time (default all three)
+     --csv     also write the results as CSV to FILE (- = stdout, and
+               then nothing else is printed there)
+
+   Each stage gets its input ready-made, so a stage's time is only its
+   own work:
+     lex    next_token() over the mapped file, lexemes as views
+     parse  syntax_run() on the file's tokens, no tree written
+     check  the file's tokens into the checker, then its pass over them
+   Reported: the best and the median of the runs, in MB/s (10^6 bytes of
+   source) and tokens/s, both from the best run. The CSV has one line per
+   file and stage:
+     file,stage,bytes,tokens,runs,best_s,median_s,mb_per_s,tokens_per_s,syntax_errors
+   Syntax errors are counted, not printed, and semantic messages are
+   dropped. A file with syntax errors (the errors, comments and strings
+   corpora) is not a valid program: its parse and check lines time the
+   error path, mostly panic_recover, and say so ("error path" on the
+   console, syntax_errors > 0 in the CSV; empty for lex). */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* the file loaders of each tool are unused here */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+#include "KSHARP_SYNTAX2.0.c"
+#include "ksharp_semantic.c"
+
+#include <limits.h>
+#include <time.h>
+
+#define BENCH_MAX_RUNS 1000
+
+enum { STAGE_LEX = 1, STAGE_PARSE = 2, STAGE_CHECK = 4 };
+
+static const ScanKernels *g_scan;
+static uint8_t *g_types = NULL;           /* TokenType of every parser token */
+static size_t   g_captypes = 0;
+static FILE    *g_null = NULL;            /* the checker's messages go here */
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* ---------------- the stages ---------------- */
+
+/* lex_once:
+   One pass of the lexer. Returns the number of tokens (EOF included). */
+static size_t lex_once(const Source *src) {
+    Lexer L;
+    size_t n = 0;
+    memset(&L, 0, sizeof L);
+    L.buf = src->data;
+    L.len = src->len;
+    L.line = 1;
+    L.scan = g_scan;
+    for (;;) {
+        Token t = next_token(&L);
+        n++;
+        if (t.type == TOK_EOF) break;
+    }
+    return n;
+}
+
+/* load_parser_tokens:
+   Lexes the file into the parser tokens (texts in g_names, types in g_types), as
+   the syntax analyzer would load them. Returns 0 if out of memory or
+   there are more tokens than the parser can count. */
+static int load_parser_tokens(const Source *src) {
+    Lexer L;
+    memset(&L, 0, sizeof L);
+    L.buf = src->data;
+    L.len = src->len;
+    L.line = 1;
+    L.lazy_pos = 1;
+    L.scan = g_scan;
+
+    g_tok_count = 0;
+    ksh_intern_reset(&g_names);
+    for (;;) {
+        Token t = next_token(&L);
+        if (g_tok_count == INT_MAX) return 0;
+        if (!grow((void **)&g_types, &g_captypes, (size_t)g_tok_count, 1, 1)) return 0;
+        g_types[g_tok_count] = (uint8_t)t.type;
+        if (t.type == TOK_EOF) {
+            if (!push_token(PT_EOF, KSYM_NONE, "EOF")) return 0;
+            break;
+        }
+        int n;
+        const char *text = token_text(&t, &n);
+        const char *lex = ksh_intern_str(&g_names, text, (size_t)n);
+        if (!lex || !push_token(map_type(t.type), t.sym, lex)) return 0;
+    }
+    line_index_free(&L);
+    return 1;
+}
+
+static void count_syntax_error(void *ctx, const char *msg, int tok) {
+    (void)msg;
+    (void)tok;
+    (*(size_t *)ctx)++;
+}
+
+/* parse_once:
+   One parse of the loaded tokens. Returns 0 if out of memory. */
+static int parse_once(size_t *errors) {
+    *errors = 0;
+    g_error_ctx = errors;
+    return syntax_run() != 2 && !g_ast_oom;
+}
+
+/* check_once:
+   The loaded tokens into the checker, and its pass. Returns 0 if out
+   of memory. */
+static int check_once(void) {
+    reset_st_tokens();
+    for (int i = 0; i + 1 < g_tok_count; i++)   /* not the EOF token */
+        if (!add_token(g_tok_text[i], (TokenType)g_types[i], (KtokSym)g_tok_sym[i]))
+            return 0;
+    return analyze();
+}
+
+/* ---------------- timing and reporting ---------------- */
+
+typedef struct {
+    const char *file;
+    const char *stage;
+    size_t bytes, tokens;
+    int runs;
+    double best, median;
+    long errors;                          /* syntax errors, -1 = not for this stage */
+} Result;
+
+static void report(const Result *r, FILE *csv, int console) {
+    double mb = r->best > 0 ? (double)r->bytes / 1e6 / r->best : 0;
+    double tps = r->best > 0 ? (double)r->tokens / r->best : 0;
+    if (console) {
+        printf("  %-6s %10.1f MB/s %12.0f tokens/s   best %.4f s, median %.4f s\n",
+               r->stage, mb, tps, r->best, r->median);
+        if (r->errors > 0)
+            printf("         (error path: %ld syntax errors, not a parse of valid code)\n",
+                   r->errors);
+    }
+    if (csv) {
+        fprintf(csv, "%s,%s,%zu,%zu,%d,%.6f,%.6f,%.2f,%.0f,", r->file, r->stage,
+                r->bytes, r->tokens, r->runs, r->best, r->median, mb, tps);
+        if (r->errors >= 0) fprintf(csv, "%ld", r->errors);
+        fputc('\n', csv);
+    }
+}
+
+/* bench_file:
+   Times the chosen stages on one file. Returns 0 if something failed. */
+static int bench_file(const char *path, int stages, int runs, FILE *csv, int console) {
+    static double t[BENCH_MAX_RUNS];
+    Source src = {0};
+    Result r;
+    int ok = 1;
+
+    if (!load_source(path, &src)) {
+        fprintf(stderr, "Error: cannot read file: %s\n", path);
+        return 0;
+    }
+    if (console) printf("%s: %zu bytes\n", path, src.len);
+    r.file = path;
+    r.bytes = src.len;
+    r.runs = runs;
+    r.errors = -1;
+
+    if (stages & STAGE_LEX) {
+        r.tokens = lex_once(&src);                  /* warm-up */
+        for (int k = 0; k < runs; k++) {
+            double t0 = now();
+            lex_once(&src);
+            t[k] = now() - t0;
+        }
+        qsort(t, (size_t)runs, sizeof t[0], cmp_double);
+        r.stage = "lex";
+        r.best = t[0];
+        r.median = t[runs / 2];
+        report(&r, csv, console);
+    }
+
+    if (stages & (STAGE_PARSE | STAGE_CHECK)) {
+        if (!load_parser_tokens(&src)) {
+            fprintf(stderr, "Error: out of memory (or too many tokens) for %s\n", path);
+            release_source(&src);
+            return 0;
+        }
+        r.tokens = (size_t)g_tok_count;
+        size_t errors = 0;                  /* one untimed parse: is it valid K#? */
+        g_error_hook = count_syntax_error;
+        g_out = g_null;
+        ok = parse_once(&errors);
+        g_error_hook = NULL;
+        g_out = NULL;
+        if (!ok) {
+            fprintf(stderr, "Error: out of memory parsing %s\n", path);
+            ast_reset();
+            release_source(&src);
+            return 0;
+        }
+        r.errors = (long)errors;
+    }
+
+    if (stages & STAGE_PARSE) {
+        size_t errors = 0;
+        g_error_hook = count_syntax_error;
+        g_out = g_null;
+        for (int k = 0; ok && k < runs; k++) {
+            double t0 = now();
+            ok = parse_once(&errors);
+            t[k] = now() - t0;
+        }
+        g_error_hook = NULL;
+        g_out = NULL;
+        if (!ok) {
+            fprintf(stderr, "Error: out of memory parsing %s\n", path);
+        } else {
+            qsort(t, (size_t)runs, sizeof t[0], cmp_double);
+            r.stage = "parse";
+            r.best = t[0];
+            r.median = t[runs / 2];
+            report(&r, csv, console);
+        }
+    }
+
+    if (ok && (stages & STAGE_CHECK)) {
+        sem_out = g_null;
+        ok = check_once();
+        for (int k = 0; ok && k < runs; k++) {
+            double t0 = now();
+            ok = check_once();
+            t[k] = now() - t0;
+        }
+        sem_out = NULL;
+        if (!ok) {
+            fprintf(stderr, "Error: out of memory checking %s\n", path);
+        } else {
+            qsort(t, (size_t)runs, sizeof t[0], cmp_double);
+            r.stage = "check";
+            r.tokens = (size_t)token_count;
+            r.best = t[0];
+            r.median = t[runs / 2];
+            report(&r, csv, console);
+        }
+    }
+
+    ast_reset();
+    release_source(&src);
+    return ok;
+}
+
+/* ---------------- main ---------------- */
+
+/* after_prefix:
+   What follows prefix in s, or NULL if s does not start with it. */
+static const char *after_prefix(const char *s, const char *prefix) {
+    while (*prefix)
+        if (*s++ != *prefix++) return NULL;
+    return s;
+}
+
+/* parse_stages:
+   "lex,check" -> STAGE_LEX | STAGE_CHECK; 0 if a name is unknown. */
+static int parse_stages(const char *s) {
+    int stages = 0;
+    while (*s) {
+        const char *e = s;
+        while (*e && *e != ',') e++;
+        size_t n = (size_t)(e - s);
+        if (n == 3 && after_prefix(s, "lex")) stages |= STAGE_LEX;
+        else if (n == 5 && after_prefix(s, "parse")) stages |= STAGE_PARSE;
+        else if (n == 5 && after_prefix(s, "check")) stages |= STAGE_CHECK;
+        else return 0;
+        s = *e ? e + 1 : e;
+    }
+    return stages;
+}
+
+int main(int argc, char **argv) {
+    int runs = 5, stages = STAGE_LEX | STAGE_PARSE | STAGE_CHECK, nfiles = 0;
+    const char *csv_path = NULL;
+
+    for (int a = 1; a < argc; a++) {
+        const char *v;
+        if ((v = after_prefix(argv[a], "--runs="))) runs = atoi(v);
+        else if ((v = after_prefix(argv[a], "--stages="))) stages = parse_stages(v);
+        else if ((v = after_prefix(argv[a], "--csv="))) csv_path = v;
+        else if (argv[a][0] == '-' && argv[a][1] == '-') {
+            fprintf(stderr, "Error: unknown option: %s\n", argv[a]);
+            return 1;
+        }
+        else nfiles++;
+    }
+    if (!nfiles || runs < 1 || runs > BENCH_MAX_RUNS || !stages) {
+        fprintf(stderr, "usage: ksharp_bench [--runs=N] [--stages=lex,parse,check]"
+                        " [--csv=FILE] file.ksh...\n");
+        return 1;
+    }
+
+    FILE *csv = NULL;
+    int console = 1;
+    if (csv_path && same_str(csv_path, "-")) {
+        csv = stdout;
+        console = 0;
+    } else if (csv_path && !(csv = fopen(csv_path, "w"))) {
+        fprintf(stderr, "Error: cannot create %s\n", csv_path);
+        return 1;
+    }
+    if (csv) fprintf(csv, "file,stage,bytes,tokens,runs,best_s,median_s,mb_per_s,tokens_per_s,"
+                          "syntax_errors\n");
+
+    g_null = fopen("/dev/null", "w");
+    if (!g_null) {
+        fprintf(stderr, "Error: cannot open /dev/null\n");
+        return 1;
+    }
+    g_scan = select_kernels();
+    g_tree_format = TREE_NONE;
+
+    int status = 0;
+    for (int a = 1; a < argc; a++) {
+        if (argv[a][0] == '-' && argv[a][1] == '-') continue;
+        if (!bench_file(argv[a], stages, runs, csv, console)) status = 1;
+    }
+
+    if (csv && csv != stdout && fclose(csv) != 0) {
+        fprintf(stderr, "Error: cannot write %s\n", csv_path);
+        status = 1;
+    }
+    fclose(g_null);
+    free(g_types);
+    free_st_tokens();
+    ast_free();
+    free_tokens();
+    return status;
+}
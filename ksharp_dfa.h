@@ -0,0 +1,3784 @@
+/* ksharp_dfa.h
+   Generated by ksharp_dfagen from ksharp_tokens.spec; do not edit, change
+   the spec (make -f MakeFile writes this file again).
+
+   scan_token() reads the token at L->pos (there is one: L->pos < L->len)
+   with the minimized DFA of the spec's 79 rules, 198 states. A state is
+   a label (stN, commented with the shortest text that leads to it), an
+   action is a label (acN, rule N) that makes the token and leaves
+   L->pos after it. */
+
+/* DFA_BITS: bit k = byte is in the loop set k of some states */
+static const unsigned char DFA_BITS[256] = {
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x01,0x01,0x00,0x01,0x01,  // 00-0F
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // 10-1F
+  0x00,0x00,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,  // 20-2F
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x00,0x00,0x00,0x00,0x00,0x01,  // 30-3F
+  0x01,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,  // 40-4F
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x00,0x01,0x00,0x01,0x02,  // 50-5F
+  0x01,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,  // 60-6F
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x00,0x00,0x00,0x01,0x01,  // 70-7F
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // 80-8F
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // 90-9F
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // A0-AF
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // B0-BF
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // C0-CF
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // D0-DF
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,  // E0-EF
+  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01  // F0-FF
+};
+
+static Token scan_token(Lexer* L){
+  const char* s = L->buf;
+  size_t p = L->pos, n = L->len;
+  unsigned c = (unsigned char)s[p];
+  Token t;
+
+  // st0: the first byte (there is one)
+  switch (c){
+    case 0x09: case 0x0A: case 0x0D: case ' ':
+      goto st2;
+    case '!':
+      goto st3;
+    case '"':
+      goto st4;
+    case '%':
+      goto st5;
+    case '&':
+      goto st6;
+    case '\'':
+      goto st7;
+    case '(':
+      goto st8;
+    case ')':
+      goto st9;
+    case '*':
+      goto st10;
+    case '+':
+      goto st11;
+    case ',':
+      goto st12;
+    case '-':
+      goto st13;
+    case '.':
+      goto st14;
+    case '/':
+      goto st15;
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9':
+      goto st16;
+    case ':':
+      goto st17;
+    case ';':
+      goto st18;
+    case '<':
+      goto st19;
+    case '=':
+      goto st20;
+    case '>':
+      goto st21;
+    case 'A': case 'a':
+      goto st22;
+    case 'B':
+      goto st23;
+    case 'C':
+      goto st24;
+    case 'D':
+      goto st25;
+    case 'E':
+      goto st26;
+    case 'F':
+      goto st27;
+    case 'G': case 'H': case 'J': case 'K': case 'L': case 'N': case 'Q': case 'R':
+    case 'S': case 'U': case 'W': case 'X': case 'Y': case 'Z': case '_': case 'g':
+    case 'h': case 'j': case 'k': case 'l': case 'n': case 'q': case 'x': case 'y':
+    case 'z':
+      goto st28;
+    case 'I':
+      goto st29;
+    case 'M': case 'm':
+      goto st30;
+    case 'O':
+      goto st31;
+    case 'P':
+      goto st32;
+    case 'T':
+      goto st33;
+    case 'V': case 'v':
+      goto st34;
+    case '[':
+      goto st35;
+    case ']':
+      goto st36;
+    case 'b':
+      goto st37;
+    case 'c':
+      goto st38;
+    case 'd':
+      goto st39;
+    case 'e':
+      goto st40;
+    case 'f':
+      goto st41;
+    case 'i':
+      goto st42;
+    case 'o':
+      goto st43;
+    case 'p':
+      goto st44;
+    case 'r':
+      goto st45;
+    case 's':
+      goto st46;
+    case 't':
+      goto st47;
+    case 'u':
+      goto st48;
+    case 'w':
+      goto st49;
+    case '{':
+      goto st50;
+    case '|':
+      goto st51;
+    case '}':
+      goto st52;
+    default: goto st1;
+  }
+
+st1:                              // "\x00" TOK_UNKNOWN
+  p++;
+  if (p - L->tok_start >= UNKNOWN_RUN_MAX) goto ac77;
+  if (p >= n) goto ac77;
+  c = (unsigned char)s[p];
+  if (DFA_BITS[c] & 0x01) goto st1;
+  goto ac77;
+
+st2:                              // "\x09" TOK_UNKNOWN
+  p++;
+  goto ac78;
+
+st3:                              // "!" TOK_OP_LOGIC
+  p++;
+  if (p >= n) goto ac59;
+  c = (unsigned char)s[p];
+  if (c == '=') goto st53;
+  goto ac59;
+
+st4:                              // "\"" TOK_UNKNOWN
+  p = L->scan->find_str_stop(s, p + 1, n);
+  if (p >= n) goto ac45;
+  c = (unsigned char)s[p];
+  if (c < '"') goto ac45;
+  if (c < '\\') goto st54;
+  goto st55;
+
+st5:                              // "%" TOK_OP_ARITH
+  p++;
+  goto ac65;
+
+st6:                              // "&" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac78;
+  c = (unsigned char)s[p];
+  if (c == '&') goto st56;
+  goto ac78;
+
+st7:                              // "'" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac47;
+  c = (unsigned char)s[p];
+  if (c == '\\') goto st58;
+  goto st57;
+
+st8:                              // "(" TOK_BRACKET
+  p++;
+  goto ac71;
+
+st9:                              // ")" TOK_BRACKET
+  p++;
+  goto ac72;
+
+st10:                             // "*" TOK_OP_ARITH
+  p++;
+  if (p >= n) goto ac63;
+  c = (unsigned char)s[p];
+  if (c == '*') goto st59;
+  goto ac63;
+
+st11:                             // "+" TOK_OP_ARITH
+  p++;
+  goto ac61;
+
+st12:                             // "," TOK_DELIM
+  p++;
+  goto ac68;
+
+st13:                             // "-" TOK_OP_ARITH
+  p++;
+  goto ac62;
+
+st14:                             // "." TOK_DELIM
+  p++;
+  goto ac70;
+
+st15:                             // "/" TOK_OP_ARITH
+  p++;
+  if (p >= n) goto ac64;
+  c = (unsigned char)s[p];
+  if (c < '+'){
+    if (c < '*') goto ac64;
+    goto st60;
+  }
+  if (c == '/') goto st61;
+  goto ac64;
+
+st16:                             // "0" TOK_CONST_INT
+  p++;
+  if (p >= n) goto ac41;
+  c = (unsigned char)s[p];
+  if (c >= '0' && c <= '9') goto st16;
+  if (c == '.') goto st62;
+  goto ac41;
+
+st17:                             // ":" TOK_DELIM
+  p++;
+  goto ac69;
+
+st18:                             // ";" TOK_DELIM
+  p++;
+  goto ac67;
+
+st19:                             // "<" TOK_OP_REL
+  p++;
+  if (p >= n) goto ac55;
+  c = (unsigned char)s[p];
+  if (c == '=') goto st63;
+  goto ac55;
+
+st20:                             // "=" TOK_ASSIGN
+  p++;
+  if (p >= n) goto ac66;
+  c = (unsigned char)s[p];
+  if (c == '=') goto st64;
+  goto ac66;
+
+st21:                             // ">" TOK_OP_REL
+  p++;
+  if (p >= n) goto ac56;
+  c = (unsigned char)s[p];
+  if (c == '=') goto st65;
+  goto ac56;
+
+st22:                             // "A" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st66;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st23:                             // "B" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'p': case 'q': case 'r': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'e':
+      goto st67;
+    case 'o':
+      goto st68;
+    default: goto ac40;
+  }
+
+st24:                             // "C" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'h'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'i') goto st69;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st25:                             // "D" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'J': case 'K': case 'L': case 'M': case 'N': case 'O':
+    case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W':
+    case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'j': case 'k': case 'l': case 'm':
+    case 'n': case 'p': case 'q': case 'r': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'I': case 'i':
+      goto st70;
+    case 'o':
+      goto st71;
+    default: goto ac40;
+  }
+
+st26:                             // "E" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st72;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st27:                             // "F" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'm':
+    case 'n': case 'o': case 'p': case 'q': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'a':
+      goto st73;
+    case 'l':
+      goto st74;
+    case 'r':
+      goto st75;
+    default: goto ac40;
+  }
+
+st28:                             // "G" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (DFA_BITS[c] & 0x02) goto st28;
+  goto ac40;
+
+st29:                             // "I" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st76;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st30:                             // "M" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W':
+    case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'p': case 'q': case 'r': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'O': case 'o':
+      goto st77;
+    default: goto ac40;
+  }
+
+st31:                             // "O" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'f'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'g') goto st78;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st32:                             // "P" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st79;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st33:                             // "T" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'p': case 'q': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'h':
+      goto st80;
+    case 'o':
+      goto st81;
+    case 'r':
+      goto st82;
+    default: goto ac40;
+  }
+
+st34:                             // "V" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'o'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'p') goto st83;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st35:                             // "[" TOK_BRACKET
+  p++;
+  goto ac73;
+
+st36:                             // "]" TOK_BRACKET
+  p++;
+  goto ac74;
+
+st37:                             // "b" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'p': case 'q': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'e':
+      goto st84;
+    case 'o':
+      goto st68;
+    case 'r':
+      goto st85;
+    default: goto ac40;
+  }
+
+st38:                             // "c" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'i': case 'j': case 'k': case 'l': case 'm':
+    case 'n': case 'p': case 'q': case 'r': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'a':
+      goto st86;
+    case 'h':
+      goto st69;
+    case 'o':
+      goto st87;
+    default: goto ac40;
+  }
+
+st39:                             // "d" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'J': case 'K': case 'L': case 'M': case 'N': case 'O':
+    case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W':
+    case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c': case 'd':
+    case 'f': case 'g': case 'h': case 'j': case 'k': case 'l': case 'm': case 'n':
+    case 'p': case 'q': case 'r': case 's': case 't': case 'u': case 'v': case 'w':
+    case 'x': case 'y': case 'z':
+      goto st28;
+    case 'I': case 'i':
+      goto st70;
+    case 'e':
+      goto st88;
+    case 'o':
+      goto st89;
+    default: goto ac40;
+  }
+
+st40:                             // "e" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k':
+    case 'm': case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'l':
+      goto st90;
+    case 'n':
+      goto st91;
+    default: goto ac40;
+  }
+
+st41:                             // "f" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'm':
+    case 'n': case 'p': case 'q': case 's': case 't': case 'u': case 'v': case 'w':
+    case 'x': case 'y': case 'z':
+      goto st28;
+    case 'a':
+      goto st73;
+    case 'l':
+      goto st74;
+    case 'o':
+      goto st92;
+    case 'r':
+      goto st75;
+    default: goto ac40;
+  }
+
+st42:                             // "i" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'f':
+      goto st93;
+    case 'n':
+      goto st94;
+    default: goto ac40;
+  }
+
+st43:                             // "o" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'f'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'g') goto st95;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st44:                             // "p" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k':
+    case 'm': case 'n': case 'o': case 'p': case 'q': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'l':
+      goto st79;
+    case 'r':
+      goto st96;
+    default: goto ac40;
+  }
+
+st45:                             // "r" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st97;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st46:                             // "s" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'w'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'x') goto st98;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st47:                             // "t" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'p': case 'q': case 's': case 't': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'h':
+      goto st99;
+    case 'o':
+      goto st81;
+    case 'r':
+      goto st82;
+    default: goto ac40;
+  }
+
+st48:                             // "u" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st100;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st49:                             // "w" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'o': case 'p': case 'q': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'h':
+      goto st101;
+    case 'r':
+      goto st102;
+    default: goto ac40;
+  }
+
+st50:                             // "{" TOK_BRACKET
+  p++;
+  goto ac75;
+
+st51:                             // "|" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac78;
+  c = (unsigned char)s[p];
+  if (c == '|') goto st103;
+  goto ac78;
+
+st52:                             // "}" TOK_BRACKET
+  p++;
+  goto ac76;
+
+st53:                             // "!=" TOK_OP_REL
+  p++;
+  goto ac52;
+
+st54:                             // "\"\"" TOK_CONST_STRING
+  p++;
+  goto ac44;
+
+st55:                             // "\"\\" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac45;
+  goto st4;
+
+st56:                             // "&&" TOK_OP_LOGIC
+  p++;
+  goto ac57;
+
+st57:                             // "'\x00" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac47;
+  c = (unsigned char)s[p];
+  if (c == '\'') goto st104;
+  goto ac47;
+
+st58:                             // "'\\" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac47;
+  goto st57;
+
+st59:                             // "**" TOK_OP_ARITH
+  p++;
+  goto ac60;
+
+st60:                             // "/*" TOK_UNKNOWN
+  p = L->scan->find_star(s, p + 1, n);
+  if (p >= n) goto ac50;
+  goto st105;
+
+st61:                             // "//" TOK_COMMENT
+  p = L->scan->find_newline(s, p + 1, n);
+  goto ac48;
+
+st62:                             // "0." TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac43;
+  c = (unsigned char)s[p];
+  if (c >= '0' && c <= '9') goto st106;
+  goto ac43;
+
+st63:                             // "<=" TOK_OP_REL
+  p++;
+  goto ac53;
+
+st64:                             // "==" TOK_OP_REL
+  p++;
+  goto ac51;
+
+st65:                             // ">=" TOK_OP_REL
+  p++;
+  goto ac54;
+
+st66:                             // "An" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'd'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'e') goto st107;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st67:                             // "Be" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'g'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'h') goto st108;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st68:                             // "Bo" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'o'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'p') goto st109;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st69:                             // "Ch" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st110;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st70:                             // "DI" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'W':
+    case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'o': case 'p': case 'q': case 'r': case 's': case 't':
+    case 'u': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'V': case 'v':
+      goto st111;
+    default: goto ac40;
+  }
+
+st71:                             // "Do" TOK_NOISE
+  p++;
+  if (p >= n) goto ac22;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac22;
+      goto st28;
+    }
+    if (c < 'A') goto ac22;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac22;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac22;
+
+st72:                             // "En" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'd'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'e') goto st112;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st73:                             // "Fa" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st113;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st74:                             // "Fl" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'o'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'p') goto st114;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st75:                             // "Fr" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'o'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'p') goto st115;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st76:                             // "In" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st116;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st77:                             // "MO" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'E': case 'F': case 'G':
+    case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N': case 'O':
+    case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V': case 'W':
+    case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c': case 'e':
+    case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l': case 'm':
+    case 'n': case 'o': case 'p': case 'q': case 'r': case 's': case 't': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'D': case 'd':
+      goto st117;
+    default: goto ac40;
+  }
+
+st78:                             // "Of" TOK_NOISE
+  p++;
+  if (p >= n) goto ac26;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac26;
+      goto st28;
+    }
+    if (c < 'A') goto ac26;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac26;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac26;
+
+st79:                             // "Pl" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st118;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st80:                             // "Th" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st119;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st81:                             // "To" TOK_NOISE
+  p++;
+  if (p >= n) goto ac29;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac29;
+      goto st28;
+    }
+    if (c < 'A') goto ac29;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac29;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac29;
+
+st82:                             // "Tr" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'u'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'v') goto st120;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st83:                             // "Vo" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st121;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st84:                             // "be" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'g'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'h') goto st122;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st85:                             // "br" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st123;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st86:                             // "ca" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 's'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 't') goto st124;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st87:                             // "co" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st125;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st88:                             // "de" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'f'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'g') goto st126;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st89:                             // "do" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac5;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac5;
+      goto st28;
+    }
+    if (c < 'A') goto ac5;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac5;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac5;
+
+st90:                             // "el" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 's'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 't') goto st127;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st91:                             // "en" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'd'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'e') goto st128;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st92:                             // "fo" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'r'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 's') goto st129;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st93:                             // "if" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac0;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac0;
+      goto st28;
+    }
+    if (c < 'A') goto ac0;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac0;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac0;
+
+st94:                             // "in" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'a': case 'b': case 'c':
+    case 'd': case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k':
+    case 'l': case 'm': case 'n': case 'o': case 'q': case 'r': case 's': case 'u':
+    case 'v': case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'p':
+      goto st130;
+    case 't':
+      goto st116;
+    default: goto ac40;
+  }
+
+st95:                             // "of" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac19;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac19;
+      goto st28;
+    }
+    if (c < 'A') goto ac19;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac19;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac19;
+
+st96:                             // "pr" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st131;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st97:                             // "re" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  switch (c){
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7':
+    case '8': case '9': case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
+    case 'G': case 'H': case 'I': case 'J': case 'K': case 'L': case 'M': case 'N':
+    case 'O': case 'P': case 'Q': case 'R': case 'S': case 'T': case 'U': case 'V':
+    case 'W': case 'X': case 'Y': case 'Z': case '_': case 'b': case 'c': case 'd':
+    case 'e': case 'f': case 'g': case 'h': case 'i': case 'j': case 'k': case 'l':
+    case 'm': case 'n': case 'o': case 'q': case 'r': case 's': case 'u': case 'v':
+    case 'w': case 'x': case 'y': case 'z':
+      goto st28;
+    case 'a':
+      goto st132;
+    case 'p':
+      goto st133;
+    case 't':
+      goto st134;
+    default: goto ac40;
+  }
+
+st98:                             // "sw" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st135;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st99:                             // "th" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st136;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st100:                            // "un" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st137;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st101:                            // "wh" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st138;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st102:                            // "wr" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st139;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st103:                            // "||" TOK_OP_LOGIC
+  p++;
+  goto ac58;
+
+st104:                            // "'\x00'" TOK_CONST_CHAR
+  p++;
+  goto ac46;
+
+st105:                            // "/**" TOK_UNKNOWN
+  p++;
+  if (p >= n) goto ac50;
+  c = (unsigned char)s[p];
+  if (c == '*') goto st105;
+  if (c == '/') goto st140;
+  goto st60;
+
+st106:                            // "0.0" TOK_CONST_FLOAT
+  p++;
+  if (p >= n) goto ac42;
+  c = (unsigned char)s[p];
+  if (c >= '0' && c <= '9') goto st106;
+  goto ac42;
+
+st107:                            // "And" TOK_NOISE
+  p++;
+  if (p >= n) goto ac28;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac28;
+      goto st28;
+    }
+    if (c < 'A') goto ac28;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac28;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac28;
+
+st108:                            // "Beg" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st141;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st109:                            // "Boo" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st142;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st110:                            // "Cha" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'r'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 's') goto st143;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st111:                            // "DIV" TOK_OP_ARITH
+  p++;
+  if (p >= n) goto ac38;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac38;
+      goto st28;
+    }
+    if (c < 'A') goto ac38;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac38;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac38;
+
+st112:                            // "End" TOK_NOISE
+  p++;
+  if (p >= n) goto ac24;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac24;
+      goto st28;
+    }
+    if (c < 'A') goto ac24;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac24;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac24;
+
+st113:                            // "Fal" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 's'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 't') goto st144;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st114:                            // "Flo" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st145;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st115:                            // "Fro" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'm'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'n') goto st146;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st116:                            // "Int" TOK_RESERVED_TYPE
+  p++;
+  if (p >= n) goto ac31;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac31;
+      goto st28;
+    }
+    if (c < 'A') goto ac31;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac31;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac31;
+
+st117:                            // "MOD" TOK_OP_ARITH
+  p++;
+  if (p >= n) goto ac39;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac39;
+      goto st28;
+    }
+    if (c < 'A') goto ac39;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac39;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac39;
+
+st118:                            // "Ple" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st147;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st119:                            // "The" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st148;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st120:                            // "Tru" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st149;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st121:                            // "Voi" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'd'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'e') goto st150;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st122:                            // "beg" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st151;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st123:                            // "bre" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st152;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st124:                            // "cas" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st153;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st125:                            // "con" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st154;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st126:                            // "def" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st155;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st127:                            // "els" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st156;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st128:                            // "end" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac17;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac17;
+      goto st28;
+    }
+    if (c < 'A') goto ac17;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac17;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac17;
+
+st129:                            // "for" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac3;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac3;
+      goto st28;
+    }
+    if (c < 'A') goto ac3;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac3;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac3;
+
+st130:                            // "inp" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'u'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'v') goto st157;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st131:                            // "pri" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st158;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st132:                            // "rea" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'd'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'e') goto st159;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st133:                            // "rep" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st160;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st134:                            // "ret" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'u'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'v') goto st161;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st135:                            // "swi" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st162;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st136:                            // "the" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st163;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st137:                            // "unt" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st164;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st138:                            // "whi" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st165;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st139:                            // "wri" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st166;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st140:                            // "/**/" TOK_COMMENT
+  p++;
+  goto ac49;
+
+st141:                            // "Begi" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st167;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st142:                            // "Bool" TOK_RESERVED_TYPE
+  p++;
+  if (p >= n) goto ac34;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac34;
+      goto st28;
+    }
+    if (c < 'A') goto ac34;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac34;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac34;
+
+st143:                            // "Char" TOK_RESERVED_TYPE
+  p++;
+  if (p >= n) goto ac33;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac33;
+      goto st28;
+    }
+    if (c < 'A') goto ac33;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac33;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac33;
+
+st144:                            // "Fals" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st168;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st145:                            // "Floa" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st169;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st146:                            // "From" TOK_NOISE
+  p++;
+  if (p >= n) goto ac30;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac30;
+      goto st28;
+    }
+    if (c < 'A') goto ac30;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac30;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac30;
+
+st147:                            // "Plea" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 's'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 't') goto st170;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st148:                            // "Then" TOK_NOISE
+  p++;
+  if (p >= n) goto ac25;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac25;
+      goto st28;
+    }
+    if (c < 'A') goto ac25;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac25;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac25;
+
+st149:                            // "True" TOK_CONST_BOOL
+  p++;
+  if (p >= n) goto ac36;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac36;
+      goto st28;
+    }
+    if (c < 'A') goto ac36;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac36;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac36;
+
+st150:                            // "Void" TOK_RESERVED_TYPE
+  p++;
+  if (p >= n) goto ac35;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac35;
+      goto st28;
+    }
+    if (c < 'A') goto ac35;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac35;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac35;
+
+st151:                            // "begi" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st171;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st152:                            // "brea" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'k'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'l') goto st172;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st153:                            // "case" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac7;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac7;
+      goto st28;
+    }
+    if (c < 'A') goto ac7;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac7;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac7;
+
+st154:                            // "cont" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'j') goto st173;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st155:                            // "defa" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'u'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'v') goto st174;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st156:                            // "else" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac1;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac1;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac1;
+  }
+  if (c < 'i'){
+    if (c == '`') goto ac1;
+    goto st28;
+  }
+  if (c < 'j') goto st175;
+  if (c < '{') goto st28;
+  goto ac1;
+
+st157:                            // "inpu" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st176;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st158:                            // "prin" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st177;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st159:                            // "read" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st178;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st160:                            // "repe" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'a'){
+    if (c < '`') goto st28;
+    goto ac40;
+  }
+  if (c < 'b') goto st179;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st161:                            // "retu" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'r'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 's') goto st180;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st162:                            // "swit" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'c'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'd') goto st181;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st163:                            // "then" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac18;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac18;
+      goto st28;
+    }
+    if (c < 'A') goto ac18;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac18;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac18;
+
+st164:                            // "unti" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st182;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st165:                            // "whil" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st183;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st166:                            // "writ" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st184;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st167:                            // "Begin" TOK_NOISE
+  p++;
+  if (p >= n) goto ac23;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac23;
+      goto st28;
+    }
+    if (c < 'A') goto ac23;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac23;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac23;
+
+st168:                            // "False" TOK_CONST_BOOL
+  p++;
+  if (p >= n) goto ac37;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac37;
+      goto st28;
+    }
+    if (c < 'A') goto ac37;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac37;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac37;
+
+st169:                            // "Float" TOK_RESERVED_TYPE
+  p++;
+  if (p >= n) goto ac32;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac32;
+      goto st28;
+    }
+    if (c < 'A') goto ac32;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac32;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac32;
+
+st170:                            // "Pleas" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st185;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st171:                            // "begin" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac16;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac16;
+      goto st28;
+    }
+    if (c < 'A') goto ac16;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac16;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac16;
+
+st172:                            // "break" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac9;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac9;
+      goto st28;
+    }
+    if (c < 'A') goto ac9;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac9;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac9;
+
+st173:                            // "conti" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st186;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st174:                            // "defau" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st187;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st175:                            // "elsei" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'f'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'g') goto st188;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st176:                            // "input" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac13;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac13;
+      goto st28;
+    }
+    if (c < 'A') goto ac13;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac13;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac13;
+
+st177:                            // "print" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac12;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac12;
+      goto st28;
+    }
+    if (c < 'A') goto ac12;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac12;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac12;
+
+st178:                            // "readl" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st189;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st179:                            // "repea" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st190;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st180:                            // "retur" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st191;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st181:                            // "switc" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'h'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'i') goto st192;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st182:                            // "until" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac21;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac21;
+      goto st28;
+    }
+    if (c < 'A') goto ac21;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac21;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac21;
+
+st183:                            // "while" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac4;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac4;
+      goto st28;
+    }
+    if (c < 'A') goto ac4;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac4;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac4;
+
+st184:                            // "write" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'l'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'm') goto st193;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st185:                            // "Please" TOK_NOISE
+  p++;
+  if (p >= n) goto ac27;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac27;
+      goto st28;
+    }
+    if (c < 'A') goto ac27;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac27;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac27;
+
+st186:                            // "contin" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'u'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'v') goto st194;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st187:                            // "defaul" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 't'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'u') goto st195;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st188:                            // "elseif" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac2;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac2;
+      goto st28;
+    }
+    if (c < 'A') goto ac2;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac2;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac2;
+
+st189:                            // "readln" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac15;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac15;
+      goto st28;
+    }
+    if (c < 'A') goto ac15;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac15;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac15;
+
+st190:                            // "repeat" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac20;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac20;
+      goto st28;
+    }
+    if (c < 'A') goto ac20;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac20;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac20;
+
+st191:                            // "return" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac11;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac11;
+      goto st28;
+    }
+    if (c < 'A') goto ac11;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac11;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac11;
+
+st192:                            // "switch" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac6;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac6;
+      goto st28;
+    }
+    if (c < 'A') goto ac6;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac6;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac6;
+
+st193:                            // "writel" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'n'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'o') goto st196;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st194:                            // "continu" TOK_IDENTIFIER
+  p++;
+  if (p >= n) goto ac40;
+  c = (unsigned char)s[p];
+  if (c < '_'){
+    if (c < ':'){
+      if (c < '0') goto ac40;
+      goto st28;
+    }
+    if (c >= 'A' && c <= 'Z') goto st28;
+    goto ac40;
+  }
+  if (c < 'e'){
+    if (c == '`') goto ac40;
+    goto st28;
+  }
+  if (c < 'f') goto st197;
+  if (c < '{') goto st28;
+  goto ac40;
+
+st195:                            // "default" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac8;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac8;
+      goto st28;
+    }
+    if (c < 'A') goto ac8;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac8;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac8;
+
+st196:                            // "writeln" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac14;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac14;
+      goto st28;
+    }
+    if (c < 'A') goto ac14;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac14;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac14;
+
+st197:                            // "continue" TOK_KEYWORD
+  p++;
+  if (p >= n) goto ac10;
+  c = (unsigned char)s[p];
+  if (c < '['){
+    if (c < ':'){
+      if (c < '0') goto ac10;
+      goto st28;
+    }
+    if (c < 'A') goto ac10;
+    goto st28;
+  }
+  if (c < '`'){
+    if (c < '_') goto ac10;
+    goto st28;
+  }
+  if (c >= 'a' && c <= 'z') goto st28;
+  goto ac10;
+
+ac0:                              // "if"  (line 36)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_IF;
+  return t;
+
+ac1:                              // "else"  (line 37)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_ELSE;
+  return t;
+
+ac2:                              // "elseif"  (line 38)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_ELSEIF;
+  return t;
+
+ac3:                              // "for"  (line 39)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_FOR;
+  return t;
+
+ac4:                              // "while"  (line 40)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_WHILE;
+  return t;
+
+ac5:                              // "do"  (line 41)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_DO;
+  return t;
+
+ac6:                              // "switch"  (line 42)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_SWITCH;
+  return t;
+
+ac7:                              // "case"  (line 43)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_CASE;
+  return t;
+
+ac8:                              // "default"  (line 44)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_DEFAULT;
+  return t;
+
+ac9:                              // "break"  (line 45)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_BREAK;
+  return t;
+
+ac10:                             // "continue"  (line 46)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_CONTINUE;
+  return t;
+
+ac11:                             // "return"  (line 47)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_RETURN;
+  return t;
+
+ac12:                             // "print"  (line 48)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_PRINT;
+  return t;
+
+ac13:                             // "input"  (line 49)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_INPUT;
+  return t;
+
+ac14:                             // "writeln"  (line 50)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_WRITELN;
+  return t;
+
+ac15:                             // "readln"  (line 51)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_READLN;
+  return t;
+
+ac16:                             // "begin"  (line 52)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_BEGIN;
+  return t;
+
+ac17:                             // "end"  (line 53)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_END;
+  return t;
+
+ac18:                             // "then"  (line 54)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_THEN;
+  return t;
+
+ac19:                             // "of"  (line 55)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_OF;
+  return t;
+
+ac20:                             // "repeat"  (line 56)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_REPEAT;
+  return t;
+
+ac21:                             // "until"  (line 57)
+  L->pos = p;
+  t = make_view(L, TOK_KEYWORD, L->tok_start, (int)(p - L->tok_start), NULL);
+  t.sym = KSYM_UNTIL;
+  return t;
+
+ac22:                             // "Do"  (line 61)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac23:                             // "Begin"  (line 62)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac24:                             // "End"  (line 63)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac25:                             // "Then"  (line 64)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac26:                             // "Of"  (line 65)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac27:                             // [pP] "lease"  (line 68)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac28:                             // [aA] "nd"  (line 69)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac29:                             // [tT] "o"  (line 70)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac30:                             // [fF] "rom"  (line 71)
+  L->pos = p;
+  return make_view(L, TOK_NOISE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac31:                             // [iI] "nt"  (line 72)
+  L->pos = p;
+  return make_view(L, TOK_RESERVED_TYPE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac32:                             // [fF] "loat"  (line 73)
+  L->pos = p;
+  return make_view(L, TOK_RESERVED_TYPE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac33:                             // [cC] "har"  (line 74)
+  L->pos = p;
+  return make_view(L, TOK_RESERVED_TYPE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac34:                             // [bB] "ool"  (line 75)
+  L->pos = p;
+  return make_view(L, TOK_RESERVED_TYPE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac35:                             // [vV] "oid"  (line 76)
+  L->pos = p;
+  return make_view(L, TOK_RESERVED_TYPE, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac36:                             // [tT] "rue"  (line 77)
+  L->pos = p;
+  return make_view(L, TOK_CONST_BOOL, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac37:                             // [fF] "alse"  (line 78)
+  L->pos = p;
+  return make_view(L, TOK_CONST_BOOL, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac38:                             // 'div'  (line 81)
+  L->pos = p;
+  t = make_view(L, TOK_OP_ARITH, L->tok_start, (int)(p - L->tok_start), "DIV");
+  t.sym = KSYM_DIV;
+  return t;
+
+ac39:                             // 'mod'  (line 82)
+  L->pos = p;
+  t = make_view(L, TOK_OP_ARITH, L->tok_start, (int)(p - L->tok_start), "MOD");
+  t.sym = KSYM_MOD;
+  return t;
+
+ac40:                             // letter word*  (line 84)
+  L->pos = p;
+  return make_view(L, TOK_IDENTIFIER, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac41:                             // digit+  (line 87)
+  L->pos = p;
+  return make_view(L, TOK_CONST_INT, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac42:                             // digit+ "." digit+  (line 88)
+  L->pos = p;
+  return make_view(L, TOK_CONST_FLOAT, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac43:                             // digit+ "."  (line 89)
+  L->pos = p;
+  return make(L, TOK_UNKNOWN, "<bad_float>", 11, NULL);
+
+ac44:                             // "\"" ([^"\\\n] | "\\" any)* "\""  (line 94)
+  L->pos = p;
+  return make_view(L, TOK_CONST_STRING, L->tok_start + 1, (int)(p - L->tok_start) - 2, NULL);
+
+ac45:                             // "\"" ([^"\\\n] | "\\" any)* "\\"?  (line 95)
+  L->pos = p;
+  return make(L, TOK_UNKNOWN, "<unterminated_string>", 21, NULL);
+
+ac46:                             // "'" ([^\\] | "\\" any) "'"  (line 99)
+  L->pos = p;
+  return make_view(L, TOK_CONST_CHAR, L->tok_start + 1, (int)(p - L->tok_start) - 2, NULL);
+
+ac47:                             // "'" ([^\\] | "\\" any?)?  (line 100)
+  L->pos = p;
+  return make(L, TOK_UNKNOWN, "<unterminated_char>", 19, NULL);
+
+ac48:                             // "//" [^\n]*  (line 103)
+  L->pos = p;
+  return make(L, TOK_COMMENT, "//", 2, NULL);
+
+ac49:                             // "/*" ([^*] | "*"+ [^*/])* "*"+ "/"  (line 104)
+  L->pos = p;
+  return make(L, TOK_COMMENT, "/* */", 5, NULL);
+
+ac50:                             // "/*" ([^*] | "*"+ [^*/])* "*"*  (line 105)
+  L->pos = p;
+  return make(L, TOK_UNKNOWN, "<unterminated_comment>", 22, NULL);
+
+ac51:                             // "=="  (line 108)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, "==", 2, KSYM_EQ);
+
+ac52:                             // "!="  (line 109)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, "!=", 2, KSYM_NE);
+
+ac53:                             // "<="  (line 110)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, "<=", 2, KSYM_LE);
+
+ac54:                             // ">="  (line 111)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, ">=", 2, KSYM_GE);
+
+ac55:                             // "<"  (line 112)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, "<", 1, KSYM_LT);
+
+ac56:                             // ">"  (line 113)
+  L->pos = p;
+  return make_sym(L, TOK_OP_REL, ">", 1, KSYM_GT);
+
+ac57:                             // "&&"  (line 114)
+  L->pos = p;
+  return make_sym(L, TOK_OP_LOGIC, "&&", 2, KSYM_AND);
+
+ac58:                             // "||"  (line 115)
+  L->pos = p;
+  return make_sym(L, TOK_OP_LOGIC, "||", 2, KSYM_OR);
+
+ac59:                             // "!"  (line 116)
+  L->pos = p;
+  return make_sym(L, TOK_OP_LOGIC, "!", 1, KSYM_NOT);
+
+ac60:                             // "**"  (line 117)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "**", 2, KSYM_POW);
+
+ac61:                             // "+"  (line 118)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "+", 1, KSYM_PLUS);
+
+ac62:                             // "-"  (line 119)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "-", 1, KSYM_MINUS);
+
+ac63:                             // "*"  (line 120)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "*", 1, KSYM_STAR);
+
+ac64:                             // "/"  (line 121)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "/", 1, KSYM_SLASH);
+
+ac65:                             // "%"  (line 122)
+  L->pos = p;
+  return make_sym(L, TOK_OP_ARITH, "%", 1, KSYM_PERCENT);
+
+ac66:                             // "="  (line 123)
+  L->pos = p;
+  return make_sym(L, TOK_ASSIGN, "=", 1, KSYM_ASSIGN);
+
+ac67:                             // ";"  (line 126)
+  L->pos = p;
+  return make_sym(L, TOK_DELIM, ";", 1, KSYM_SEMI);
+
+ac68:                             // ","  (line 127)
+  L->pos = p;
+  return make_sym(L, TOK_DELIM, ",", 1, KSYM_COMMA);
+
+ac69:                             // ":"  (line 128)
+  L->pos = p;
+  return make_sym(L, TOK_DELIM, ":", 1, KSYM_COLON);
+
+ac70:                             // "."  (line 129)
+  L->pos = p;
+  return make_sym(L, TOK_DELIM, ".", 1, KSYM_DOT);
+
+ac71:                             // "("  (line 130)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, "(", 1, KSYM_LPAREN);
+
+ac72:                             // ")"  (line 131)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, ")", 1, KSYM_RPAREN);
+
+ac73:                             // "["  (line 132)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, "[", 1, KSYM_LBRACKET);
+
+ac74:                             // "]"  (line 133)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, "]", 1, KSYM_RBRACKET);
+
+ac75:                             // "{"  (line 134)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, "{", 1, KSYM_LBRACE);
+
+ac76:                             // "}"  (line 135)
+  L->pos = p;
+  return make_sym(L, TOK_BRACKET, "}", 1, KSYM_RBRACE);
+
+ac77:                             // [^ \t\r\n A-Za-z_0-9;,:.()\[\]{}*+\-%=<>!&|/"']+  (line 140)
+  L->pos = p;
+  return make_view(L, TOK_UNKNOWN, L->tok_start, (int)(p - L->tok_start), NULL);
+
+ac78:                             // any  (line 142)
+  L->pos = p;
+  return make_view(L, TOK_UNKNOWN, L->tok_start, (int)(p - L->tok_start), NULL);
+}
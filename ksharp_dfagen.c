@@ -0,0 +1,1137 @@
+/* ksharp_dfagen.c
+   Lexer generator: reads the token spec (ksharp_tokens.spec, format in
+   its header) and writes ksharp_dfa.h, the scan_token() DFA that
+   KSHARP2.0.C includes.
+
+   Usage:  ksharp_dfagen spec out.h
+
+   Every rule's pattern becomes an NFA (Thompson's construction), the
+   NFAs are joined and turned into one DFA (subset construction), and the
+   DFA is minimized (Moore's partition refinement). It is written out as
+   direct code, in the style of re2c: each state is a label, its
+   transitions are comparisons (a switch where there are many) and
+   gotos, and each rule has one action label that makes the token.
+   Loops are the hot spots, so a state that loops on exactly the bytes
+   of a %kernel calls that kernel, and one that loops on a set of
+   several ranges tests one bit of a table (DFA_BITS).
+
+   The longest match wins, and of two rules that match the same bytes
+   the first one. Every byte must start a token, and a token must be
+   found again on the way back from any state (the spec ends with an
+   "any" rule); the generator checks both, so scan_token() itself never
+   fails. The output depends only on the spec. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_LINE     1024
+#define MAX_NAME     64
+#define MAX_DEFS     64
+#define MAX_KERNELS  8
+#define MAX_DEPTH    32          /* nesting of names and ( )          */
+#define MAX_BITS     8           /* loop sets in DFA_BITS (one byte)  */
+#define SWITCH_SPANS 12          /* more ranges than this: a switch    */
+
+typedef struct { unsigned char b[32]; } ByteSet;
+
+static void set_add(ByteSet *s, int c) { s->b[c >> 3] |= (unsigned char)(1u << (c & 7)); }
+static int  set_has(const ByteSet *s, int c) { return (s->b[c >> 3] >> (c & 7)) & 1; }
+
+/* ---------------- errors and memory ---------------- */
+
+static const char *g_spec_path = "";
+static int g_line = 0;                    /* spec line being read, 0 = none */
+
+static void die(const char *msg, const char *arg) {
+    if (g_line) fprintf(stderr, "Error: %s:%d: %s%s\n", g_spec_path, g_line, msg, arg ? arg : "");
+    else        fprintf(stderr, "Error: %s: %s%s\n", g_spec_path, msg, arg ? arg : "");
+    exit(1);
+}
+
+static void *xrealloc(void *p, size_t n) {
+    void *q = realloc(p, n ? n : 1);
+    if (!q) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    return q;
+}
+
+/* ---------------- the NFA ----------------
+   Thompson's construction: a fragment has one start and one open end;
+   every state has at most two empty edges and one byte-set edge. */
+
+typedef struct {
+    int eps[2];              /* empty edges, -1 = none            */
+    int next;                /* target of the byte edge, -1 = none */
+    ByteSet on;              /* the bytes of that edge            */
+    int rule;                /* rule accepted here, -1 = none     */
+} NState;
+
+typedef struct { int start, end; } Frag;
+
+static NState *g_nfa = NULL;
+static int g_nn = 0, g_capn = 0;
+
+static int nfa_state(void) {
+    if (g_nn == g_capn) {
+        g_capn = g_capn ? g_capn * 2 : 1024;
+        g_nfa = (NState *)xrealloc(g_nfa, (size_t)g_capn * sizeof *g_nfa);
+    }
+    NState *s = &g_nfa[g_nn];
+    s->eps[0] = s->eps[1] = s->next = s->rule = -1;
+    memset(&s->on, 0, sizeof s->on);
+    return g_nn++;
+}
+
+static void nfa_eps(int from, int to) {
+    NState *s = &g_nfa[from];
+    if (s->eps[0] < 0) s->eps[0] = to;
+    else s->eps[1] = to;                  /* never a third: see the builders */
+}
+
+static Frag frag_empty(void) {
+    Frag f;
+    f.start = f.end = nfa_state();
+    return f;
+}
+
+static Frag frag_set(const ByteSet *on) {
+    Frag f;
+    f.start = nfa_state();
+    f.end = nfa_state();
+    g_nfa[f.start].next = f.end;
+    g_nfa[f.start].on = *on;
+    return f;
+}
+
+static Frag frag_cat(Frag a, Frag b) {
+    nfa_eps(a.end, b.start);
+    a.end = b.end;
+    return a;
+}
+
+static Frag frag_alt(Frag a, Frag b) {
+    Frag f;
+    f.start = nfa_state();
+    f.end = nfa_state();
+    nfa_eps(f.start, a.start);
+    nfa_eps(f.start, b.start);
+    nfa_eps(a.end, f.end);
+    nfa_eps(b.end, f.end);
+    return f;
+}
+
+/* frag_repeat:
+   a* (min 0, many), a+ (min 1, many) or a? (min 0, once). */
+static Frag frag_repeat(Frag a, int min, int many) {
+    Frag f;
+    f.start = min ? a.start : nfa_state();
+    f.end = nfa_state();
+    if (!min) {
+        nfa_eps(f.start, a.start);
+        nfa_eps(f.start, f.end);
+    }
+    if (many) nfa_eps(a.end, a.start);
+    nfa_eps(a.end, f.end);
+    return f;
+}
+
+/* ---------------- the spec ---------------- */
+
+enum { ACT_TEXT, ACT_BODY, ACT_LABEL, ACT_SYM };
+
+typedef struct {
+    int line;                    /* where it is in the spec           */
+    char type[MAX_NAME];         /* TokenType                         */
+    char sym[MAX_NAME];          /* KtokSym, "" = none                */
+    char limit[MAX_NAME];        /* longest token, "" = no limit      */
+    int action;                  /* ACT_*                             */
+    char label[MAX_LINE];        /* ACT_LABEL / ACT_SYM: static label */
+    int label_len;
+    char extra[MAX_LINE];        /* extra label, when has_extra       */
+    int extra_len, has_extra;
+    char src[MAX_LINE];          /* the pattern as written            */
+    Frag nfa;
+} Rule;
+
+typedef struct {
+    char name[MAX_NAME];
+    char text[MAX_LINE];         /* the pattern, parsed at every use */
+} Def;
+
+typedef struct {
+    char name[MAX_NAME];         /* member of ScanKernels */
+    ByteSet skips;               /* the bytes it skips    */
+} Kernel;
+
+static Rule  *g_rules = NULL;
+static int    g_nrules = 0, g_caprules = 0;
+static Def    g_defs[MAX_DEFS];
+static int    g_ndefs = 0;
+static Kernel g_kernels[MAX_KERNELS];
+static int    g_nkernels = 0;
+
+static const char *g_p;          /* pattern parser cursor */
+
+static int is_name_start(int c) { return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+static int is_name_char(int c)  { return is_name_start(c) || (c >= '0' && c <= '9'); }
+
+static void skip_blanks(void) {
+    while (*g_p == ' ' || *g_p == '\t') g_p++;
+}
+
+/* read_name:
+   A C identifier at g_p into out (MAX_NAME); 0 if there is none. */
+static int read_name(char *out) {
+    int n = 0;
+    if (!is_name_start((unsigned char)*g_p)) return 0;
+    while (is_name_char((unsigned char)*g_p)) {
+        if (n == MAX_NAME - 1) die("name too long", NULL);
+        out[n++] = *g_p++;
+    }
+    out[n] = 0;
+    return 1;
+}
+
+static int hex_digit(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* read_byte:
+   One byte of a text or a set at g_p, escapes decoded. */
+static int read_byte(void) {
+    int c = (unsigned char)*g_p++;
+    if (!c) die("unexpected end of line", NULL);
+    if (c != '\\') return c;
+    c = (unsigned char)*g_p++;
+    switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case '0': return 0;
+        case 'x': {
+            int h = hex_digit((unsigned char)g_p[0]), l = h < 0 ? -1 : hex_digit((unsigned char)g_p[1]);
+            if (l < 0) die("bad \\x escape", NULL);
+            g_p += 2;
+            return h * 16 + l;
+        }
+        case '\\': case '"': case '\'': case '[': case ']': case '-': case '^':
+            return c;
+    }
+    die("unknown escape", NULL);
+    return 0;
+}
+
+/* read_text:
+   A "..." (or '...') text at g_p, decoded into out; returns its length. */
+static int read_text(char *out, int cap) {
+    int quote = *g_p++, n = 0;
+    while (*g_p != quote) {
+        int c = read_byte();
+        if (n == cap - 1) die("text too long", NULL);
+        out[n++] = (char)c;
+    }
+    g_p++;
+    out[n] = 0;
+    return n;
+}
+
+static Frag parse_alt(int depth);
+
+/* parse_set:
+   [a-z_] or [^...] at g_p. */
+static Frag parse_set(void) {
+    ByteSet on, out;
+    int neg;
+    memset(&on, 0, sizeof on);
+    g_p++;
+    neg = *g_p == '^';
+    if (neg) g_p++;
+    while (*g_p != ']') {
+        int lo = read_byte(), hi = lo;
+        if (*g_p == '-' && g_p[1] != ']') {
+            g_p++;
+            hi = read_byte();
+            if (hi < lo) die("backwards range in a set", NULL);
+        }
+        for (int c = lo; c <= hi; c++) set_add(&on, c);
+    }
+    g_p++;
+    memset(&out, 0, sizeof out);
+    for (int c = 0; c < 256; c++)
+        if (set_has(&on, c) != neg) set_add(&out, c);
+    return frag_set(&out);
+}
+
+/* parse_atom:
+   A text, a set, any, a name or ( ... ). */
+static Frag parse_atom(int depth) {
+    char buf[MAX_LINE];
+    if (*g_p == '"' || *g_p == '\'') {
+        int fold = *g_p == '\'';
+        int n = read_text(buf, MAX_LINE);
+        Frag f = frag_empty();
+        for (int i = 0; i < n; i++) {
+            ByteSet on;
+            int c = (unsigned char)buf[i];
+            memset(&on, 0, sizeof on);
+            set_add(&on, c);
+            if (fold && c >= 'a' && c <= 'z') set_add(&on, c - 'a' + 'A');
+            if (fold && c >= 'A' && c <= 'Z') set_add(&on, c - 'A' + 'a');
+            f = frag_cat(f, frag_set(&on));
+        }
+        return f;
+    }
+    if (*g_p == '[') return parse_set();
+    if (*g_p == '(') {
+        g_p++;
+        Frag f = parse_alt(depth + 1);
+        if (*g_p != ')') die("missing )", NULL);
+        g_p++;
+        return f;
+    }
+    if (read_name(buf)) {
+        if (!strcmp(buf, "any")) {
+            ByteSet on;
+            memset(&on, 0xFF, sizeof on);
+            return frag_set(&on);
+        }
+        for (int d = 0; d < g_ndefs; d++) {
+            if (strcmp(g_defs[d].name, buf)) continue;
+            if (depth >= MAX_DEPTH) die("names nested too deep: ", buf);
+            const char *save = g_p;
+            g_p = g_defs[d].text;
+            Frag f = parse_alt(depth + 1);
+            if (*g_p) die("bad pattern in the definition of ", buf);
+            g_p = save;
+            return f;
+        }
+        die("unknown name: ", buf);
+    }
+    die("unexpected character in a pattern: ", g_p);
+    return frag_empty();
+}
+
+/* parse_post:
+   An atom and its * + ? marks. */
+static Frag parse_post(int depth) {
+    Frag f = parse_atom(depth);
+    for (;;) {
+        skip_blanks();
+        if (*g_p == '*') f = frag_repeat(f, 0, 1);
+        else if (*g_p == '+') f = frag_repeat(f, 1, 1);
+        else if (*g_p == '?') f = frag_repeat(f, 0, 0);
+        else return f;
+        g_p++;
+    }
+}
+
+/* parse_seq:
+   Atoms one after the other, up to | ) => or the end. */
+static Frag parse_seq(int depth) {
+    Frag f;
+    int have = 0;
+    for (;;) {
+        skip_blanks();
+        if (!*g_p || *g_p == '|' || *g_p == ')' || (g_p[0] == '=' && g_p[1] == '>'))
+            return have ? f : frag_empty();
+        Frag a = parse_post(depth);
+        f = have ? frag_cat(f, a) : a;
+        have = 1;
+    }
+}
+
+static Frag parse_alt(int depth) {
+    if (depth > MAX_DEPTH) die("pattern nested too deep", NULL);
+    Frag f = parse_seq(depth);
+    while (*g_p == '|') {
+        g_p++;
+        f = frag_alt(f, parse_seq(depth));
+    }
+    return f;
+}
+
+/* strip_comment:
+   Cut line at a '#' that is not inside a text or a set, and the blanks
+   and line end before it. */
+static void strip_comment(char *line) {
+    char *p = line, *end;
+    while (*p && *p != '#') {
+        if (*p == '"' || *p == '\'' || *p == '[') {
+            int close = *p == '[' ? ']' : *p;
+            p++;
+            while (*p && *p != close) p += (*p == '\\' && p[1]) ? 2 : 1;
+            if (*p) p++;
+        } else p++;
+    }
+    *p = 0;
+    end = p;
+    while (end > line && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n'))
+        *--end = 0;
+}
+
+/* parse_action:
+   What follows => on a rule line. */
+static void parse_action(Rule *r, const char *pattern) {
+    char word[MAX_NAME];
+    skip_blanks();
+    if (!read_name(r->type)) die("missing token type after =>", NULL);
+    for (;;) {
+        skip_blanks();
+        if (!*g_p) break;
+        if (!read_name(word)) die("unexpected text in an action: ", g_p);
+        if (!strncmp(word, "KSYM_", 5)) {
+            strcpy(r->sym, word);
+        } else if (!strcmp(word, "body")) {
+            r->action = ACT_BODY;
+        } else if (!strcmp(word, "sym")) {
+            const char *save = g_p;    /* the label is the pattern's one text */
+            g_p = pattern;
+            skip_blanks();
+            if (*g_p != '"') die("sym needs a pattern that is one \"text\"", NULL);
+            r->label_len = read_text(r->label, MAX_LINE);
+            skip_blanks();
+            if (g_p[0] != '=' || g_p[1] != '>') die("sym needs a pattern that is one \"text\"", NULL);
+            g_p = save;
+            r->action = ACT_SYM;
+        } else if (!strcmp(word, "label") || !strcmp(word, "extra")) {
+            int label = word[0] == 'l';
+            skip_blanks();
+            if (*g_p != '"') die("expected a \"text\" after ", word);
+            if (label) {
+                r->label_len = read_text(r->label, MAX_LINE);
+                r->action = ACT_LABEL;
+            } else {
+                r->extra_len = read_text(r->extra, MAX_LINE);
+                r->has_extra = 1;
+            }
+        } else if (!strcmp(word, "limit")) {
+            skip_blanks();
+            if (!read_name(r->limit)) die("expected a name after limit", NULL);
+        } else die("unknown action word: ", word);
+    }
+    if (r->has_extra && r->action != ACT_TEXT && r->action != ACT_BODY)
+        die("extra goes with the matched text only", NULL);
+}
+
+/* read_spec:
+   All definitions, kernels and rules of the spec file. */
+static void read_spec(const char *path) {
+    char line[MAX_LINE + 2];
+    FILE *f = fopen(path, "r");
+    if (!f) die("cannot open the spec", NULL);
+    g_line = 0;
+    while (fgets(line, sizeof line, f)) {
+        g_line++;
+        if (strlen(line) > MAX_LINE) die("line too long", NULL);
+        strip_comment(line);
+        g_p = line;
+        skip_blanks();
+        if (!*g_p) continue;
+
+        if (*g_p == '%') {                                /* %kernel name [set] */
+            char word[MAX_NAME];
+            g_p++;
+            if (!read_name(word) || strcmp(word, "kernel")) die("unknown directive", NULL);
+            if (g_nkernels == MAX_KERNELS) die("too many kernels", NULL);
+            Kernel *k = &g_kernels[g_nkernels++];
+            skip_blanks();
+            if (!read_name(k->name)) die("expected a kernel name", NULL);
+            skip_blanks();
+            Frag fr = parse_alt(0);
+            if (*g_p || g_nfa[fr.start].next != fr.end || g_nfa[fr.start].eps[0] >= 0)
+                die("a kernel takes one [set]", NULL);
+            k->skips = g_nfa[fr.start].on;
+            continue;
+        }
+
+        const char *start = g_p;
+        char name[MAX_NAME];
+        if (read_name(name)) {                            /* name = pattern ? */
+            skip_blanks();
+            if (g_p[0] == '=' && g_p[1] != '>') {
+                if (g_ndefs == MAX_DEFS) die("too many definitions", NULL);
+                Def *d = &g_defs[g_ndefs];
+                g_p++;
+                skip_blanks();
+                strcpy(d->name, name);
+                strcpy(d->text, g_p);
+                parse_alt(0);                             /* check it now */
+                if (*g_p) die("bad pattern", NULL);
+                g_ndefs++;
+                continue;
+            }
+            g_p = start;
+        }
+
+        if (g_nrules == g_caprules) {                    /* pattern => action */
+            g_caprules = g_caprules ? g_caprules * 2 : 64;
+            g_rules = (Rule *)xrealloc(g_rules, (size_t)g_caprules * sizeof *g_rules);
+        }
+        Rule *r = &g_rules[g_nrules];
+        memset(r, 0, sizeof *r);
+        r->line = g_line;
+        r->nfa = parse_alt(0);
+        if (g_p[0] != '=' || g_p[1] != '>') die("expected => after the pattern", NULL);
+        size_t n = (size_t)(g_p - start);
+        while (n && (start[n - 1] == ' ' || start[n - 1] == '\t')) n--;
+        memcpy(r->src, start, n);
+        r->src[n] = 0;
+        g_p += 2;
+        parse_action(r, start);
+        g_nfa[r->nfa.end].rule = g_nrules++;
+    }
+    if (ferror(f)) die("cannot read the spec", NULL);
+    fclose(f);
+    g_line = 0;
+    if (!g_nrules) die("no rules", NULL);
+}
+
+/* ---------------- subset construction ----------------
+   A DFA state is a set of NFA states (a bit set of g_words words),
+   found again through an open-addressing hash table. */
+
+static int g_words;                      /* uint64_t per NFA set      */
+static uint64_t *g_dsets = NULL;         /* the set of every DFA state */
+static int *g_dnext = NULL;              /* [state * 256 + byte]       */
+static int *g_drule = NULL;              /* accepted rule, -1 = none   */
+static int g_nd = 0, g_capd = 0;
+static int *g_hash = NULL;               /* DFA state + 1, 0 = empty   */
+static size_t g_hcap = 0;
+
+static size_t set_hash(const uint64_t *s) {
+    uint64_t h = 1469598103934665603ull;
+    for (int i = 0; i < g_words; i++) h = (h ^ s[i]) * 1099511628211ull;
+    return (size_t)(h ^ (h >> 29));
+}
+
+/* closure:
+   Add to s every NFA state reachable from it by empty edges. */
+static void closure(uint64_t *s, int *stack) {
+    int top = 0;
+    for (int i = 0; i < g_nn; i++)
+        if (s[i >> 6] >> (i & 63) & 1) stack[top++] = i;
+    while (top) {
+        const NState *q = &g_nfa[stack[--top]];
+        for (int k = 0; k < 2; k++) {
+            int t = q->eps[k];
+            if (t >= 0 && !(s[t >> 6] >> (t & 63) & 1)) {
+                s[t >> 6] |= 1ull << (t & 63);
+                stack[top++] = t;
+            }
+        }
+    }
+}
+
+static void hash_insert(int d) {
+    size_t i = set_hash(g_dsets + (size_t)d * g_words) & (g_hcap - 1);
+    while (g_hash[i]) i = (i + 1) & (g_hcap - 1);
+    g_hash[i] = d + 1;
+}
+
+/* dfa_state:
+   The DFA state of NFA set s, made if it is new. */
+static int dfa_state(const uint64_t *s) {
+    size_t w = (size_t)g_words;
+    if (g_hcap) {
+        size_t i = set_hash(s) & (g_hcap - 1);
+        for (; g_hash[i]; i = (i + 1) & (g_hcap - 1))
+            if (!memcmp(g_dsets + (size_t)(g_hash[i] - 1) * w, s, w * sizeof *s)) return g_hash[i] - 1;
+    }
+    if (g_nd == g_capd) {
+        g_capd = g_capd ? g_capd * 2 : 256;
+        g_dsets = (uint64_t *)xrealloc(g_dsets, (size_t)g_capd * w * sizeof *g_dsets);
+        g_dnext = (int *)xrealloc(g_dnext, (size_t)g_capd * 256 * sizeof *g_dnext);
+        g_drule = (int *)xrealloc(g_drule, (size_t)g_capd * sizeof *g_drule);
+    }
+    int d = g_nd++;
+    memcpy(g_dsets + (size_t)d * w, s, w * sizeof *s);
+    g_drule[d] = -1;
+    for (int i = 0; i < g_nn; i++)
+        if ((s[i >> 6] >> (i & 63) & 1) && g_nfa[i].rule >= 0 &&
+            (g_drule[d] < 0 || g_nfa[i].rule < g_drule[d]))
+            g_drule[d] = g_nfa[i].rule;              /* the first rule wins */
+    if ((size_t)g_nd * 2 > g_hcap) {                 /* keep it half empty */
+        g_hcap = g_hcap ? g_hcap * 2 : 1024;
+        g_hash = (int *)xrealloc(g_hash, g_hcap * sizeof *g_hash);
+        memset(g_hash, 0, g_hcap * sizeof *g_hash);
+        for (int e = 0; e < g_nd; e++) hash_insert(e);
+    } else hash_insert(d);
+    return d;
+}
+
+static void build_dfa(void) {
+    int start = nfa_state();                 /* empty edges to every rule */
+    int at = start;
+    for (int r = 0; r < g_nrules; r++) {
+        if (r == g_nrules - 1) { nfa_eps(at, g_rules[r].nfa.start); break; }
+        int next = nfa_state();
+        nfa_eps(at, g_rules[r].nfa.start);
+        nfa_eps(at, next);
+        at = next;
+    }
+
+    g_words = (g_nn + 63) / 64;
+    uint64_t *s = (uint64_t *)xrealloc(NULL, (size_t)g_words * sizeof *s);
+    int *stack = (int *)xrealloc(NULL, (size_t)g_nn * sizeof *stack);
+    int *members = (int *)xrealloc(NULL, (size_t)g_nn * sizeof *members);
+    memset(s, 0, (size_t)g_words * sizeof *s);
+    s[start >> 6] |= 1ull << (start & 63);
+    closure(s, stack);
+    dfa_state(s);
+
+    for (int d = 0; d < g_nd; d++) {
+        int nm = 0;                          /* NFA states with a byte edge */
+        for (int i = 0; i < g_nn; i++)
+            if ((g_dsets[(size_t)d * g_words + (i >> 6)] >> (i & 63) & 1) && g_nfa[i].next >= 0)
+                members[nm++] = i;
+        for (int c = 0; c < 256; c++) {
+            int any = 0;
+            memset(s, 0, (size_t)g_words * sizeof *s);
+            for (int k = 0; k < nm; k++) {
+                const NState *q = &g_nfa[members[k]];
+                if (set_has(&q->on, c)) {
+                    s[q->next >> 6] |= 1ull << (q->next & 63);
+                    any = 1;
+                }
+            }
+            int t = -1;
+            if (any) {
+                closure(s, stack);
+                t = dfa_state(s);
+            }
+            g_dnext[(size_t)d * 256 + c] = t;
+        }
+    }
+    free(s);
+    free(stack);
+    free(members);
+}
+
+/* ---------------- minimization ----------------
+   Moore: start from one class per accepted rule (and one for none),
+   split classes whose states go to different classes on some byte,
+   until nothing splits. The result is numbered breadth first from the
+   start state, so state 0 is the start. */
+
+static int *g_cls = NULL;                /* class of each DFA state      */
+static int *g_sig = NULL;                /* [state * 257]: class, targets */
+
+static int cmp_sig(const void *a, const void *b) {
+    const int *x = g_sig + (size_t)*(const int *)a * 257, *y = g_sig + (size_t)*(const int *)b * 257;
+    for (int i = 0; i < 257; i++)
+        if (x[i] != y[i]) return x[i] < y[i] ? -1 : 1;
+    return 0;
+}
+
+static int  g_nm = 0;                    /* states of the minimal DFA */
+static int *g_next = NULL;               /* [state * 256 + byte], -1 = none */
+static int *g_rule = NULL;               /* accepted rule, -1 = none  */
+static int *g_parent = NULL;             /* breadth-first parent, -1 at start */
+static int *g_pbyte = NULL;              /* byte from the parent      */
+
+static void minimize(void) {
+    int *order = (int *)xrealloc(NULL, (size_t)g_nd * sizeof *order);
+    int *ncls = (int *)xrealloc(NULL, (size_t)g_nd * sizeof *ncls);
+    g_cls = (int *)xrealloc(NULL, (size_t)g_nd * sizeof *g_cls);
+    g_sig = (int *)xrealloc(NULL, (size_t)g_nd * 257 * sizeof *g_sig);
+    for (int d = 0; d < g_nd; d++) g_cls[d] = g_drule[d] + 1;
+
+    int count = -1;
+    for (;;) {
+        for (int d = 0; d < g_nd; d++) {
+            int *sg = g_sig + (size_t)d * 257;
+            sg[0] = g_cls[d];
+            for (int c = 0; c < 256; c++) {
+                int t = g_dnext[(size_t)d * 256 + c];
+                sg[c + 1] = t < 0 ? -1 : g_cls[t];
+            }
+            order[d] = d;
+        }
+        qsort(order, (size_t)g_nd, sizeof *order, cmp_sig);
+        int k = 0;
+        for (int i = 0; i < g_nd; i++) {
+            if (i && cmp_sig(&order[i - 1], &order[i])) k++;
+            ncls[order[i]] = k;
+        }
+        memcpy(g_cls, ncls, (size_t)g_nd * sizeof *g_cls);
+        if (k + 1 == count) break;
+        count = k + 1;
+    }
+
+    int *num = (int *)xrealloc(NULL, (size_t)count * sizeof *num);   /* class -> new number */
+    int *rep = (int *)xrealloc(NULL, (size_t)count * sizeof *rep);   /* new number -> a DFA state */
+    for (int i = 0; i < count; i++) num[i] = -1;
+    g_next = (int *)xrealloc(NULL, (size_t)count * 256 * sizeof *g_next);
+    g_rule = (int *)xrealloc(NULL, (size_t)count * sizeof *g_rule);
+    g_parent = (int *)xrealloc(NULL, (size_t)count * sizeof *g_parent);
+    g_pbyte = (int *)xrealloc(NULL, (size_t)count * sizeof *g_pbyte);
+    num[g_cls[0]] = 0;
+    rep[0] = 0;
+    g_parent[0] = g_pbyte[0] = -1;
+    g_nm = 1;
+    for (int m = 0; m < g_nm; m++) {          /* breadth first */
+        int d = rep[m];
+        g_rule[m] = g_drule[d];
+        for (int c = 0; c < 256; c++) {
+            int t = g_dnext[(size_t)d * 256 + c];
+            if (t >= 0 && num[g_cls[t]] < 0) {
+                num[g_cls[t]] = g_nm;
+                rep[g_nm] = t;
+                g_parent[g_nm] = m;
+                g_pbyte[g_nm] = c;
+                g_nm++;
+            }
+            g_next[(size_t)m * 256 + c] = t < 0 ? -1 : num[g_cls[t]];
+        }
+    }
+    free(order);
+    free(ncls);
+    free(num);
+    free(rep);
+    free(g_sig);
+}
+
+/* ---------------- checks ---------------- */
+
+static int *g_mark = NULL;      /* 1 = the state must remember itself (mark/acc) */
+static int  g_need_back = 0;    /* some state has no rule: back to the mark      */
+
+static void check_dfa(void) {
+    char num[16];
+    for (int c = 0; c < 256; c++)
+        if (g_next[c] < 0) {
+            snprintf(num, sizeof num, "0x%02X", c);
+            die("no rule matches a token that starts with byte ", num);
+        }
+    if (g_rule[0] >= 0) die("a rule matches the empty text: ", g_rules[g_rule[0]].src);
+
+    int *used = (int *)xrealloc(NULL, (size_t)g_nrules * sizeof *used);
+    memset(used, 0, (size_t)g_nrules * sizeof *used);
+    for (int m = 0; m < g_nm; m++)
+        if (g_rule[m] >= 0) used[g_rule[m]] = 1;
+    for (int r = 0; r < g_nrules; r++)
+        if (!used[r]) {
+            g_line = g_rules[r].line;
+            die("this rule never makes a token (an earlier one takes its matches)", NULL);
+        }
+    free(used);
+
+    /* a state without a rule must have an accepting state on every path
+       to it; the states with a way to one remember it (mark/acc) */
+    int *seen = (int *)xrealloc(NULL, (size_t)g_nm * sizeof *seen);
+    int *stack = (int *)xrealloc(NULL, (size_t)g_nm * sizeof *stack);
+    int top = 0;
+    memset(seen, 0, (size_t)g_nm * sizeof *seen);
+    for (int c = 0; c < 256; c++) {
+        int t = g_next[c];
+        if (g_rule[t] < 0 && !seen[t]) { seen[t] = 1; stack[top++] = t; }
+    }
+    while (top) {
+        int m = stack[--top];
+        for (int c = 0; c < 256; c++) {
+            int t = g_next[(size_t)m * 256 + c];
+            if (t >= 0 && g_rule[t] < 0 && !seen[t]) { seen[t] = 1; stack[top++] = t; }
+        }
+    }
+    for (int m = 1; m < g_nm; m++)
+        if (seen[m]) die("some text starts a token that no rule ends (add an \"any\" rule)", NULL);
+    free(stack);
+
+    g_mark = (int *)xrealloc(NULL, (size_t)g_nm * sizeof *g_mark);
+    memset(seen, 0, (size_t)g_nm * sizeof *seen);             /* seen = reaches a state without rule */
+    for (int changed = 1; changed; ) {
+        changed = 0;
+        for (int m = 0; m < g_nm; m++) {
+            if (seen[m]) continue;
+            for (int c = 0; c < 256; c++) {
+                int t = g_next[(size_t)m * 256 + c];
+                if (t >= 0 && (g_rule[t] < 0 || seen[t])) { seen[m] = changed = 1; break; }
+            }
+        }
+    }
+    for (int m = 0; m < g_nm; m++) {
+        g_mark[m] = m && g_rule[m] >= 0 && seen[m];
+        if (m && g_rule[m] < 0) g_need_back = 1;
+    }
+    free(seen);
+}
+
+/* ---------------- output ---------------- */
+
+static FILE *g_out;
+static ByteSet g_bitsets[MAX_BITS];      /* the loop sets in DFA_BITS */
+static int g_nbits = 0;
+
+/* put_byte:
+   c as the generated code writes it: 'a', '\'' or 0x1F. */
+static void put_byte(int c) {
+    if (c == '\'' || c == '\\') fprintf(g_out, "'\\%c'", c);
+    else if (c >= 0x20 && c < 0x7F) fprintf(g_out, "'%c'", c);
+    else fprintf(g_out, "0x%02X", c);
+}
+
+/* put_cstr:
+   s[0..n) as a C string literal. */
+static void put_cstr(const char *s, int n) {
+    fputc('"', g_out);
+    for (int i = 0; i < n; i++) {
+        int c = (unsigned char)s[i];
+        if (c == '"' || c == '\\') fprintf(g_out, "\\%c", c);
+        else if (c >= 0x20 && c < 0x7F) fputc(c, g_out);
+        else fprintf(g_out, "\\%03o", c);
+    }
+    fputc('"', g_out);
+}
+
+/* put_prefix:
+   The shortest text that leads to state m, quoted, for its comment. */
+static void put_prefix(int m) {
+    char buf[64];
+    int n = 0;
+    for (int k = m; g_parent[k] >= 0 && n < (int)sizeof buf; k = g_parent[k]) buf[n++] = (char)g_pbyte[k];
+    fputc('"', g_out);
+    for (int i = n - 1; i >= 0; i--) {
+        int c = (unsigned char)buf[i];
+        if (c == '"' || c == '\\') fprintf(g_out, "\\%c", c);
+        else if (c >= 0x20 && c < 0x7F) fputc(c, g_out);
+        else fprintf(g_out, "\\x%02X", c);
+    }
+    fputc('"', g_out);
+}
+
+static void put_target(int t, int fail) {
+    if (t >= 0) fprintf(g_out, "goto st%d;", t);
+    else if (fail >= 0) fprintf(g_out, "goto ac%d;", fail);
+    else fprintf(g_out, "goto back;");
+}
+
+static void indent(int depth) {
+    for (int i = 0; i < depth; i++) fputs("  ", g_out);
+}
+
+typedef struct { int lo, hi, t; } Span;    /* bytes lo..hi go to t */
+
+/* put_tree:
+   Dispatch on c over spans a..b with if/else on the range bounds. */
+static void put_tree(const Span *sp, int a, int b, int depth, int fail) {
+    indent(depth);
+    if (b - a == 1) {
+        put_target(sp[a].t, fail);
+        fputc('\n', g_out);
+    } else if (b - a == 2) {
+        fputs("if (c < ", g_out);
+        put_byte(sp[a + 1].lo);
+        fputs(") ", g_out);
+        put_target(sp[a].t, fail);
+        fputc('\n', g_out);
+        indent(depth);
+        put_target(sp[a + 1].t, fail);
+        fputc('\n', g_out);
+    } else if (b - a == 3 && sp[a].t == sp[a + 2].t) {
+        const Span *m = &sp[a + 1];
+        fputs("if (c ", g_out);
+        if (m->lo == m->hi) { fputs("== ", g_out); put_byte(m->lo); }
+        else { fputs(">= ", g_out); put_byte(m->lo); fputs(" && c <= ", g_out); put_byte(m->hi); }
+        fputs(") ", g_out);
+        put_target(m->t, fail);
+        fputc('\n', g_out);
+        indent(depth);
+        put_target(sp[a].t, fail);
+        fputc('\n', g_out);
+    } else {
+        int mid = (a + b) / 2;
+        fputs("if (c < ", g_out);
+        put_byte(sp[mid].lo);
+        if (mid - a == 1) {                       /* one way down: no block */
+            fputs(") ", g_out);
+            put_target(sp[a].t, fail);
+            fputc('\n', g_out);
+        } else {
+            fputs("){\n", g_out);
+            put_tree(sp, a, mid, depth + 1, fail);
+            indent(depth);
+            fputs("}\n", g_out);
+        }
+        put_tree(sp, mid, b, depth, fail);
+    }
+}
+
+/* put_switch:
+   Dispatch on c with a switch; the target with the most bytes is the
+   default. t[c] = -2 for bytes that cannot occur. */
+static void put_switch(const int *t, int fail) {
+    int best = -3, bestn = -1;
+    for (int c = 0; c < 256; c++) {
+        int n = 0;
+        if (t[c] == -2) continue;
+        for (int e = 0; e < 256; e++) n += t[e] == t[c];
+        if (n > bestn) { bestn = n; best = t[c]; }
+    }
+    fputs("  switch (c){\n", g_out);
+    int done[256] = {0};
+    for (int c = 0; c < 256; c++) {
+        if (done[c] || t[c] == -2 || t[c] == best) continue;
+        int k = 0;
+        for (int e = c; e < 256; e++) {
+            if (t[e] != t[c]) continue;
+            done[e] = 1;
+            if (k % 8 == 0) fputs(k ? "\n    " : "    ", g_out);
+            else fputc(' ', g_out);
+            fputs("case ", g_out);
+            put_byte(e);
+            fputc(':', g_out);
+            k++;
+        }
+        fputc('\n', g_out);
+        fputs("      ", g_out);
+        put_target(t[c], fail);
+        fputc('\n', g_out);
+    }
+    fputs("    default: ", g_out);
+    put_target(best, fail);
+    fputs("\n  }\n", g_out);
+}
+
+/* put_ranges_test:
+   "c >= 'a' && c <= 'z'" (or "c == 'x'") for the one range of set s. */
+static void put_range_test(int lo, int hi) {
+    if (lo == hi) { fputs("c == ", g_out); put_byte(lo); }
+    else { fputs("c >= ", g_out); put_byte(lo); fputs(" && c <= ", g_out); put_byte(hi); }
+}
+
+/* put_state:
+   The code of state m. */
+static void put_state(int m) {
+    const int *next = g_next + (size_t)m * 256;
+    int rule = g_rule[m], fail = rule;     /* fail < 0: back to the mark */
+    int t[256], kernel = -1;
+    ByteSet self;
+    memset(&self, 0, sizeof self);
+    for (int c = 0; c < 256; c++)
+        if (next[c] == m) set_add(&self, c);
+
+    if (m) {
+        if (rule < 0 || !g_rules[rule].limit[0])
+            for (int k = 0; k < g_nkernels; k++)
+                if (!memcmp(&g_kernels[k].skips, &self, sizeof self)) kernel = k;
+        fprintf(g_out, "st%d:", m);
+        fprintf(g_out, "%*s// ", 34 - (m >= 100 ? 6 : m >= 10 ? 5 : 4), "");
+        put_prefix(m);
+        if (rule >= 0) fprintf(g_out, " %s", g_rules[rule].type);
+        fputc('\n', g_out);
+        if (kernel >= 0) fprintf(g_out, "  p = L->scan->%s(s, p + 1, n);\n", g_kernels[kernel].name);
+        else fputs("  p++;\n", g_out);
+    } else {
+        fputs("  // st0: the first byte (there is one)\n", g_out);
+    }
+
+    for (int c = 0; c < 256; c++)
+        t[c] = (kernel >= 0 && set_has(&self, c)) ? -2 : next[c];
+
+    /* the bytes left (after a kernel) may all go one way, or nowhere */
+    int one = -3, same = 1;
+    for (int c = 0; c < 256; c++) {
+        if (t[c] == -2) continue;
+        if (one == -3) one = t[c];
+        else if (t[c] != one) same = 0;
+    }
+    if (m && same && one == -1) {          /* the token ends here */
+        fputs("  ", g_out);
+        put_target(-1, fail);
+        fputc('\n', g_out);
+        return;
+    }
+    if (m) {
+        if (g_mark[m]) fprintf(g_out, "  mark = p; acc = %d;\n", rule);
+        if (rule >= 0 && g_rules[rule].limit[0])
+            fprintf(g_out, "  if (p - L->tok_start >= %s) goto ac%d;\n", g_rules[rule].limit, rule);
+        fputs("  if (p >= n) ", g_out);
+        put_target(-1, fail);
+        fputc('\n', g_out);
+    }
+    if (same && one != -3) {
+        fputs("  ", g_out);
+        put_target(one, fail);
+        fputc('\n', g_out);
+        return;
+    }
+    fputs(m ? "  c = (unsigned char)s[p];\n" : "", g_out);
+
+    if (kernel < 0 && m) {                 /* the loop first: it is the hot path */
+        int ranges = 0, lo = -1, hi = -1;
+        for (int c = 0; c < 256; c++)
+            if (set_has(&self, c) && (c == 0 || !set_has(&self, c - 1))) {
+                ranges++;
+                lo = c;
+                for (hi = c; hi < 255 && set_has(&self, hi + 1); hi++) {}
+            }
+        int bit = -1;
+        if (ranges > 1) {
+            for (int b = 0; b < g_nbits; b++)
+                if (!memcmp(&g_bitsets[b], &self, sizeof self)) bit = b;
+        }
+        if (ranges == 1 || bit >= 0) {
+            fputs("  if (", g_out);
+            if (bit >= 0) fprintf(g_out, "DFA_BITS[c] & 0x%02X", 1u << bit);
+            else put_range_test(lo, hi);
+            fprintf(g_out, ") goto st%d;\n", m);
+            for (int c = 0; c < 256; c++)
+                if (set_has(&self, c)) t[c] = -2;
+        }
+    }
+
+    Span sp[256];
+    int ns = 0, first = -2;
+    for (int c = 0; c < 256 && first == -2; c++) first = t[c];
+    for (int c = 0; c < 256; c++) {
+        int v = t[c] == -2 ? (ns ? sp[ns - 1].t : first) : t[c];   /* cannot occur: take a neighbour */
+        if (ns && sp[ns - 1].t == v) sp[ns - 1].hi = c;
+        else { sp[ns].lo = sp[ns].hi = c; sp[ns].t = v; ns++; }
+    }
+    if (ns > SWITCH_SPANS) put_switch(t, fail);
+    else put_tree(sp, 0, ns, 1, fail);
+}
+
+/* put_action:
+   The label of rule r that makes its token from tok_start..p. */
+static void put_action(int r) {
+    const Rule *R = &g_rules[r];
+    const char *slot = R->sym[0] ? R->sym : "KSYM_NONE";
+    fprintf(g_out, "ac%d:%*s// %s  (line %d)\n", r, 34 - (r >= 100 ? 6 : r >= 10 ? 5 : 4), "",
+            R->src, R->line);
+    fputs("  L->pos = p;\n", g_out);
+    if (R->action == ACT_SYM) {
+        fprintf(g_out, "  return make_sym(L, %s, ", R->type);
+        put_cstr(R->label, R->label_len);
+        fprintf(g_out, ", %d, %s);\n", R->label_len, slot);
+        return;
+    }
+    fputs(R->sym[0] ? "  t = " : "  return ", g_out);
+    if (R->action == ACT_LABEL) {
+        fprintf(g_out, "make(L, %s, ", R->type);
+        put_cstr(R->label, R->label_len);
+        fprintf(g_out, ", %d, NULL);\n", R->label_len);
+    } else {
+        if (R->action == ACT_BODY)
+            fprintf(g_out, "make_view(L, %s, L->tok_start + 1, (int)(p - L->tok_start) - 2, ", R->type);
+        else
+            fprintf(g_out, "make_view(L, %s, L->tok_start, (int)(p - L->tok_start), ", R->type);
+        if (R->has_extra) put_cstr(R->extra, R->extra_len);
+        else fputs("NULL", g_out);
+        fputs(");\n", g_out);
+    }
+    if (R->sym[0]) fprintf(g_out, "  t.sym = %s;\n  return t;\n", R->sym);
+}
+
+static void write_dfa(const char *path) {
+    int any_sym = 0;
+    for (int r = 0; r < g_nrules; r++)
+        if (g_rules[r].sym[0] && g_rules[r].action != ACT_SYM) any_sym = 1;
+
+    /* the loop sets that need a bit: more than one range, no kernel */
+    for (int m = 1; m < g_nm; m++) {
+        ByteSet self;
+        int ranges = 0, kernel = 0;
+        memset(&self, 0, sizeof self);
+        for (int c = 0; c < 256; c++)
+            if (g_next[(size_t)m * 256 + c] == m) set_add(&self, c);
+        for (int c = 0; c < 256; c++)
+            if (set_has(&self, c) && (c == 0 || !set_has(&self, c - 1))) ranges++;
+        if (g_rule[m] < 0 || !g_rules[g_rule[m]].limit[0])
+            for (int k = 0; k < g_nkernels; k++)
+                if (!memcmp(&g_kernels[k].skips, &self, sizeof self)) kernel = 1;
+        if (ranges < 2 || kernel) continue;
+        int b = 0;
+        while (b < g_nbits && memcmp(&g_bitsets[b], &self, sizeof self)) b++;
+        if (b == g_nbits && g_nbits < MAX_BITS) g_bitsets[g_nbits++] = self;
+    }
+
+    g_out = fopen(path, "w");
+    if (!g_out) die("cannot create ", path);
+    fprintf(g_out,
+        "/* ksharp_dfa.h\n"
+        "   Generated by ksharp_dfagen from ksharp_tokens.spec; do not edit, change\n"
+        "   the spec (make -f MakeFile writes this file again).\n"
+        "\n"
+        "   scan_token() reads the token at L->pos (there is one: L->pos < L->len)\n"
+        "   with the minimized DFA of the spec's %d rules, %d states. A state is\n"
+        "   a label (stN, commented with the shortest text that leads to it), an\n"
+        "   action is a label (acN, rule N) that makes the token and leaves\n"
+        "   L->pos after it. */\n\n", g_nrules, g_nm);
+
+    if (g_nbits) {
+        fputs("/* DFA_BITS: bit k = byte is in the loop set k of some states */\n", g_out);
+        fputs("static const unsigned char DFA_BITS[256] = {\n", g_out);
+        for (int c = 0; c < 256; c++) {
+            unsigned v = 0;
+            for (int b = 0; b < g_nbits; b++)
+                if (set_has(&g_bitsets[b], c)) v |= 1u << b;
+            fprintf(g_out, "%s0x%02X%s", c % 16 ? "" : "  ", v, c == 255 ? "" : ",");
+            if (c % 16 == 15) fprintf(g_out, "  // %02X-%02X\n", c - 15, c);
+        }
+        fputs("};\n\n", g_out);
+    }
+
+    fputs("static Token scan_token(Lexer* L){\n", g_out);
+    fputs("  const char* s = L->buf;\n", g_out);
+    fputs("  size_t p = L->pos, n = L->len;\n", g_out);
+    fputs("  unsigned c = (unsigned char)s[p];\n", g_out);
+    if (any_sym) fputs("  Token t;\n", g_out);
+    int any_mark = 0;
+    for (int m = 0; m < g_nm; m++) any_mark |= g_mark[m];
+    if (any_mark) fputs("  size_t mark = p;\n  int acc = 0;\n", g_out);
+    fputc('\n', g_out);
+
+    for (int m = 0; m < g_nm; m++) {
+        if (m == 0) {
+            int in = 0;                     /* a label only if some state comes back */
+            for (int k = 0; k < g_nm * 256; k++) in |= g_next[k] == 0;
+            if (in) fputs("st0:\n", g_out);
+        }
+        put_state(m);
+        fputc('\n', g_out);
+    }
+    if (g_need_back) {
+        fputs("back:                                 // no rule here: the last one that matched\n", g_out);
+        fputs("  p = mark;\n  switch (acc){\n", g_out);
+        int last = -1;
+        for (int r = 0; r < g_nrules; r++) {
+            int marked = 0;
+            for (int m = 0; m < g_nm; m++) marked |= g_mark[m] && g_rule[m] == r;
+            if (!marked) continue;
+            if (last >= 0) fprintf(g_out, "    case %d: goto ac%d;\n", last, last);
+            last = r;
+        }
+        fprintf(g_out, "    default: goto ac%d;\n  }\n", last);
+    }
+    for (int r = 0; r < g_nrules; r++) {
+        put_action(r);
+        if (r + 1 < g_nrules) fputc('\n', g_out);
+    }
+    fputs("}\n", g_out);
+    if (ferror(g_out) | fclose(g_out)) {
+        remove(path);
+        die("cannot write ", path);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: ksharp_dfagen spec out.h\n");
+        return 1;
+    }
+    g_spec_path = argv[1];
+    read_spec(argv[1]);
+    build_dfa();
+    minimize();
+    check_dfa();
+    write_dfa(argv[2]);
+    return 0;
+}
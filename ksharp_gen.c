@@ -0,0 +1,370 @@
+/* ksharp_gen.c
+   Benchmark corpus generator: repeats the programs of codes.txt until
+   the output has the size asked for.
+
+   Usage:  ksharp_gen [--mix=MIX] [--seed=N] [--codes=FILE] SIZE out.ksh
+     SIZE     bytes, or with K, M, G (1024-based): 1M, 64M, 10G
+     --mix    code      the programs without syntax errors (default)
+              errors    all programs, the broken ones too
+              comments  code with block and line comments around it
+              strings   code with string-literal prints after it
+              idents    code with long names and extra declarations
+              (all but errors use the programs without syntax errors)
+     --seed   start of the word picker (default 1)
+     --codes  where the programs come from (default codes.txt)
+
+   The output is the same for the same arguments. Every copy of a
+   program gets its own names (a -> a_17), so the semantic checker sees
+   new declarations instead of duplicates, and every copy is closed with
+   the braces it leaves open, so copies never nest. The file always ends
+   after a whole program, so it may be a little longer than SIZE.
+   The comments and strings mixes are meant for the lexer: the parser
+   reports comment tokens (it does not skip them), and K# has no string
+   type, so it reports the string prints too. Their parse and check
+   times are the error path, and ksharp_bench marks them so. */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* only scan_token is used from the lexer */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+
+/* ---------------- the programs of codes.txt ----------------
+   codes.txt has headings (a check or cross mark and a title), labels
+   (E6, M1, H10, ... and a note) and the program lines between them. */
+
+typedef struct {
+    size_t off, len;         /* program text in the codes buffer */
+    int    valid;            /* listed under a "no syntax error" heading */
+} Program;
+
+static Program *g_prog = NULL;
+static size_t   g_nprog = 0, g_capprog = 0;
+
+/* is_label:
+   E6, M1, H10 ... at the start of a line. */
+static int is_label(const char *s, const char *end) {
+    if (s >= end || (*s != 'E' && *s != 'M' && *s != 'H')) return 0;
+    const char *p = s + 1;
+    if (p >= end || *p < '0' || *p > '9') return 0;
+    while (p < end && *p >= '0' && *p <= '9') p++;
+    return p == end || *p == ' ' || *p == '\r' || *p == '\n';
+}
+
+/* add_program:
+   Keeps text[off..end) as one program unless it is only blank lines. */
+static int add_program(const char *text, size_t off, size_t end, int valid) {
+    size_t i;
+    for (i = off; i < end; i++)
+        if (text[i] != ' ' && text[i] != '\n' && text[i] != '\r' && text[i] != '\t') break;
+    if (i == end) return 1;
+    if (!grow((void **)&g_prog, &g_capprog, g_nprog, 1, sizeof(Program))) return 0;
+    g_prog[g_nprog].off = off;
+    g_prog[g_nprog].len = end - off;
+    g_prog[g_nprog].valid = valid;
+    g_nprog++;
+    return 1;
+}
+
+/* split_programs:
+   Cuts codes.txt into programs at headings and labels. */
+static int split_programs(const char *text, size_t n) {
+    size_t start = 0, pos = 0;
+    int valid = 1;
+    while (pos < n) {
+        size_t eol = pos;
+        while (eol < n && text[eol] != '\n') eol++;
+        int heading = (unsigned char)text[pos] == 0xE2;   /* U+2705 or U+274C */
+        if (heading || is_label(text + pos, text + eol)) {
+            if (!add_program(text, start, pos, valid)) return 0;
+            if (heading)
+                valid = pos + 2 < n && (unsigned char)text[pos + 1] == 0x9C &&
+                        (unsigned char)text[pos + 2] == 0x85;
+            start = eol < n ? eol + 1 : n;
+        }
+        pos = eol < n ? eol + 1 : n;
+    }
+    return add_program(text, start, n, valid);
+}
+
+/* ---------------- output ---------------- */
+
+#define GEN_BUF_SIZE (1 << 20)
+
+typedef struct {
+    FILE  *fp;
+    size_t used;             /* bytes waiting in buf */
+    unsigned long long total;/* bytes written so far (and waiting) */
+    int    failed;
+    char   buf[GEN_BUF_SIZE];
+} GenOut;
+
+static void gen_flush(GenOut *o) {
+    if (o->used && fwrite(o->buf, 1, o->used, o->fp) != o->used) o->failed = 1;
+    o->used = 0;
+}
+
+static void gen_put(GenOut *o, const char *s, size_t n) {
+    o->total += n;
+    while (n > 0) {
+        if (o->used == GEN_BUF_SIZE) gen_flush(o);
+        size_t k = GEN_BUF_SIZE - o->used;
+        if (k > n) k = n;
+        memcpy(o->buf + o->used, s, k);
+        o->used += k;
+        s += k;
+        n -= k;
+    }
+}
+
+static void gen_str(GenOut *o, const char *s) {
+    gen_put(o, s, strlen(s));
+}
+
+static void gen_num(GenOut *o, unsigned long long v) {
+    char d[24];
+    int n = 0;
+    do { d[sizeof d - 1 - n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    gen_put(o, d + sizeof d - n, (size_t)n);
+}
+
+/* ---------------- words ---------------- */
+
+static const char *const GEN_WORDS[] = {
+    "alpha", "buffer", "count", "delta", "entry", "field", "group", "index",
+    "joint", "kernel", "limit", "match", "node", "offset", "parent", "query",
+    "range", "state", "total", "unit", "value", "width", "xaxis", "yield",
+    "zone", "cache", "depth", "frame", "level", "speed", "token", "weight"
+};
+#define GEN_NWORDS (sizeof GEN_WORDS / sizeof GEN_WORDS[0])
+
+static unsigned long long g_rng;
+
+/* next_word:
+   A word picked by xorshift64 (same seed, same words). */
+static const char *next_word(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return GEN_WORDS[(g_rng >> 32) % GEN_NWORDS];
+}
+
+/* gen_words:
+   About n bytes of words separated by spaces. */
+static void gen_words(GenOut *o, size_t n) {
+    size_t done = 0;
+    while (done < n) {
+        const char *w = next_word();
+        if (done) { gen_put(o, " ", 1); done++; }
+        gen_str(o, w);
+        done += strlen(w);
+    }
+}
+
+/* is_name:
+   1 if the lexer reads the word w[0..n) as an identifier (not as a
+   keyword, type, noise word, true/false or DIV/MOD). */
+static int is_name(const char *w, size_t n) {
+    Lexer W;
+    memset(&W, 0, sizeof W);
+    W.buf = w;
+    W.len = n;
+    W.lazy_pos = 1;
+    W.scan = &SCALAR_KERNELS;
+    Token t = scan_token(&W);
+    return t.type == TOK_IDENTIFIER;
+}
+
+/* ---------------- one copy of a program ---------------- */
+
+enum { MIX_CODE, MIX_ERRORS, MIX_COMMENTS, MIX_STRINGS, MIX_IDENTS };
+
+/* gen_name:
+   A name of the program, made unique for copy k. */
+static void gen_name(GenOut *o, const char *s, size_t n, unsigned long long k, int mix) {
+    gen_put(o, s, n);
+    gen_put(o, "_", 1);
+    if (mix == MIX_IDENTS) {             /* a -> a_count_7_depth_7 */
+        gen_str(o, GEN_WORDS[k % GEN_NWORDS]);
+        gen_put(o, "_", 1);
+        gen_num(o, k);
+        gen_put(o, "_", 1);
+        gen_str(o, GEN_WORDS[(k / GEN_NWORDS + n) % GEN_NWORDS]);
+        gen_put(o, "_", 1);
+    }
+    gen_num(o, k);
+}
+
+/* gen_program:
+   Copy k of program p: identifiers renamed, open braces closed, and
+   what the mix adds around it. */
+static void gen_program(GenOut *o, const char *text, const Program *p,
+                        unsigned long long k, int mix) {
+    const char *s = text + p->off, *end = s + p->len;
+    int open = 0;
+    char last = 0;                       /* last byte copied, but not '\r' */
+
+    if (mix == MIX_COMMENTS) {
+        gen_str(o, "/* ");
+        gen_words(o, 70);
+        gen_str(o, "\n   ");
+        gen_words(o, 70);
+        gen_str(o, " */\n");
+    }
+
+    while (s < end) {
+        char c = *s;
+        if (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+            const char *w = s;
+            while (s < end && (*s == '_' || (*s >= 'a' && *s <= 'z') ||
+                               (*s >= 'A' && *s <= 'Z') || (*s >= '0' && *s <= '9')))
+                s++;
+            last = 'a';
+            if (is_name(w, (size_t)(s - w)))
+                gen_name(o, w, (size_t)(s - w), k, mix);
+            else
+                gen_put(o, w, (size_t)(s - w));
+            continue;
+        }
+        if (c == '{') open++;
+        if (c == '}' && open > 0) open--;
+        if (c == '\r') { s++; continue; }
+        if (c == '\n' && mix == MIX_COMMENTS && last == ';') {
+            gen_str(o, "  // ");
+            gen_words(o, 40);
+        }
+        gen_put(o, s, 1);
+        last = c;
+        s++;
+    }
+    while (open-- > 0) gen_str(o, "}\n");
+
+    if (mix == MIX_STRINGS) {
+        for (int i = 0; i < 3; i++) {
+            gen_str(o, "print \"");
+            gen_words(o, 40);
+            gen_str(o, " \\\"quoted\\\" \\\\ ");
+            gen_words(o, 30);
+            gen_str(o, "\";\n");
+        }
+    } else if (mix == MIX_IDENTS) {
+        for (int i = 0; i < 4; i++) {
+            const char *a = next_word(), *b = next_word();
+            gen_str(o, "int "); gen_str(o, a); gen_put(o, "_", 1); gen_str(o, b);
+            gen_put(o, "_", 1); gen_num(o, (unsigned long long)i); gen_put(o, "_", 1);
+            gen_num(o, k); gen_str(o, ";\n");
+            gen_str(o, a); gen_put(o, "_", 1); gen_str(o, b);
+            gen_put(o, "_", 1); gen_num(o, (unsigned long long)i); gen_put(o, "_", 1);
+            gen_num(o, k); gen_str(o, " = "); gen_num(o, (unsigned long long)i);
+            gen_str(o, ";\n");
+        }
+    }
+    gen_put(o, "\n", 1);
+}
+
+/* ---------------- main ---------------- */
+
+/* parse_size:
+   "64M" -> 64 * 1024 * 1024. Returns 0 if it is not a size. */
+static unsigned long long parse_size(const char *s) {
+    unsigned long long v = 0;
+    if (*s < '0' || *s > '9') return 0;
+    while (*s >= '0' && *s <= '9') v = v * 10 + (unsigned)(*s++ - '0');
+    switch (*s) {
+    case 'k': case 'K': v <<= 10; s++; break;
+    case 'm': case 'M': v <<= 20; s++; break;
+    case 'g': case 'G': v <<= 30; s++; break;
+    }
+    return *s ? 0 : v;
+}
+
+/* after_prefix:
+   What follows prefix in s, or NULL if s does not start with it. */
+static const char *after_prefix(const char *s, const char *prefix) {
+    while (*prefix)
+        if (*s++ != *prefix++) return NULL;
+    return s;
+}
+
+static GenOut g_out;                      /* one big buffer, not on the stack */
+
+int main(int argc, char **argv) {
+    static const char *const MIXES[] = { "code", "errors", "comments", "strings", "idents" };
+    const char *codes = "codes.txt", *size_arg = NULL, *path = NULL;
+    int mix = MIX_CODE;
+    g_rng = 1;
+
+    for (int a = 1; a < argc; a++) {
+        const char *s = argv[a];
+        const char *v;
+        if ((v = after_prefix(s, "--mix="))) {
+            int m = 0;
+            while (m < 5 && !same_str(v, MIXES[m])) m++;
+            if (m == 5) {
+                fprintf(stderr, "Error: unknown mix: %s\n", v);
+                return 1;
+            }
+            mix = m;
+        }
+        else if ((v = after_prefix(s, "--seed=")))
+            g_rng = strtoull(v, NULL, 10) * 2654435761u + 1;   /* never 0 */
+        else if ((v = after_prefix(s, "--codes=")))
+            codes = v;
+        else if (s[0] == '-' && s[1] == '-') {
+            fprintf(stderr, "Error: unknown option: %s\n", s);
+            return 1;
+        }
+        else if (!size_arg) size_arg = s;
+        else if (!path) path = s;
+    }
+
+    unsigned long long size = size_arg ? parse_size(size_arg) : 0;
+    if (!size || !path) {
+        fprintf(stderr, "usage: ksharp_gen [--mix=code|errors|comments|strings|idents]"
+                        " [--seed=N] [--codes=FILE] SIZE out.ksh\n");
+        return 1;
+    }
+
+    Source src = {0};
+    if (!load_source(codes, &src)) {
+        fprintf(stderr, "Error: cannot read file: %s\n", codes);
+        return 1;
+    }
+    const char *text = src.data;
+    if (!split_programs(text, src.len)) {
+        fprintf(stderr, "Error: out of memory\n");
+        release_source(&src);
+        return 1;
+    }
+
+    g_out.fp = fopen(path, "wb");
+    if (!g_out.fp) {
+        fprintf(stderr, "Error: cannot create %s\n", path);
+        release_source(&src);
+        return 1;
+    }
+
+    unsigned long long k = 0;
+    size_t used = 0;
+    for (size_t i = 0; i < g_nprog; i++) used += g_prog[i].valid || mix == MIX_ERRORS;
+    while (used && g_out.total < size && !g_out.failed) {
+        for (size_t i = 0; i < g_nprog && g_out.total < size; i++) {
+            if (!g_prog[i].valid && mix != MIX_ERRORS) continue;
+            gen_program(&g_out, text, &g_prog[i], k++, mix);
+        }
+    }
+    gen_flush(&g_out);
+
+    int status = 0;
+    if (!used) {
+        fprintf(stderr, "Error: no programs in %s\n", codes);
+        status = 1;
+    }
+    if (fclose(g_out.fp) != 0 || g_out.failed) {
+        fprintf(stderr, "Error: cannot write %s\n", path);
+        status = 1;
+    }
+    free(g_prog);
+    release_source(&src);
+    return status;
+}
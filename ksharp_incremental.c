@@ -0,0 +1,919 @@
+/* ksharp_incremental.c
+   Incremental lexing and parsing of one K# text, for editors.
+
+   A KshDoc keeps the text, its tokens and one syntax tree per top-level
+   statement. doc_edit() replaces a byte range and only redoes the work
+   around it:
+
+   - Lexing restarts after the last token that ends before the edit
+     (the scanners peek at most one byte past a token, see DocSpan) and
+     stops at the first new token that starts where an old token behind
+     the edit started. The lexer carries nothing from one token to the
+     next, so from there on the old tokens are the new ones.
+   - Parsing restarts at the first top-level statement that looked at a
+     replaced token (a statement looks at its own tokens and at the one
+     after it) and stops at the first statement boundary that falls on
+     the start of an old statement behind the change.
+
+   The text, the tokens and the statements are gap buffers whose gap
+   follows the edits. What lies behind a gap is stored relative to the
+   end: token offsets as the distance to the end of the text, statement
+   starts as the distance to the end of the token list. So the unchanged
+   tail is never touched, and an edit costs the re-lexed and re-parsed
+   part plus moving the gaps from where the last edit left them.
+   Replaced texts and subtrees stay in their pools; once they outweigh
+   the live ones the document is rebuilt from its text, which keeps
+   that cost amortized.
+
+   The tools are compiled into this file as in ksharp_pipeline.c. The
+   parser keeps its state in globals, so a document lends it its tokens
+   and node pool while it parses (doc_bind / doc_unbind); several
+   documents can be open, one is parsed at a time.
+
+   Usage:  ksharp_incremental [--check] [--no-tree | --tree=xml|json|bin]
+                              file.ksh [edits | -]
+     Loads file.ksh and applies the edits, read from the file or from
+     stdin, one per line:
+
+         OFFSET DELETE TEXT
+
+     replaces DELETE bytes at byte OFFSET by TEXT (the rest of the line;
+     \n, \t and \\ are escapes). Empty lines and lines starting with '#'
+     are skipped. Prints one [Edit] line per edit, then the diagnostics,
+     the tree and the verdict for the final text, as the syntax analyzer
+     does.
+     --check  after every edit, also lex and parse the whole text from
+              scratch and stop if the result is not the same */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* the file loaders of each tool are unused here */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+#include "KSHARP_SYNTAX2.0.c"
+
+/* ---------------- document ---------------- */
+
+/* Bytes [off, end) of the text were scanned into the token; the scanner
+   may also have peeked at the byte at end (or seen the end of the text
+   there), so a token is only kept when end lies before the edit.
+   Behind the token gap both are distances to the end of the text. */
+typedef struct {
+    uint32_t off, end;
+} DocSpan;
+
+/* One syntax error: the message and the token it was found at, counted
+   from the first token of its statement. */
+typedef struct {
+    int rel;
+    const char *msg;
+} DocDiag;
+
+/* One top-level statement: tokens [first, first + ntok) and its subtree.
+   Behind the statement gap, first is counted back from the end of the
+   token list. The tok fields of the nodes are right while the statement
+   starts at token built; doc_tree() moves them when it has moved. */
+typedef struct {
+    int first, ntok;
+    int built;
+    AstNode *node;
+    DocDiag *diag;                  /* malloc'd, NULL if there are none  */
+    int ndiag;
+} DocStmt;
+
+/* Each array holds n elements in cap slots; elements [0, gap) are at
+   their index, the others cap - n slots further. */
+typedef struct {
+    char *text;
+    size_t len, cap, gap;
+
+    uint8_t *kind;                  /* the parser's token arrays; the    */
+    uint8_t *sym;                   /* last token is EOF                 */
+    const char **lex;
+    DocSpan *span;                  /* where each token came from        */
+    size_t ntok, captok, tgap;
+    KshIntern texts;                /* token texts, one copy each        */
+
+    DocStmt *stmt;                  /* top-level statements, in order    */
+    size_t nstmt, capstmt, sgap;
+    KshPool nodes;                  /* syntax tree nodes                 */
+    AstNode *root;                  /* AST_PROGRAM, see doc_tree         */
+
+    size_t garbage;                 /* dropped tokens still in the pools */
+    size_t relexed, reparsed;       /* tokens / statements the last edit made */
+} KshDoc;
+
+#define DOC_SLACK 4096   /* garbage allowed on top of the live tokens */
+
+/* New tokens or statements, collected before they are spliced in. */
+typedef struct {
+    ParserToken *tok;
+    DocSpan *span;
+    size_t n, cap, capspan;
+} TokRun;
+
+typedef struct {
+    DocStmt *stmt;
+    size_t n, cap;
+} StmtRun;
+
+/* Errors of the statement being parsed (see doc_on_error). */
+typedef struct {
+    DocDiag *diag;
+    size_t n, cap;
+    int first;
+    int oom;
+} DiagRun;
+
+/* ---------------- gap buffers ---------------- */
+
+/* gap_move:
+   Moves the gap of an array of n used out of cap elements of size sz
+   from gap to pos. */
+static void gap_move(void *base, size_t sz, size_t n, size_t cap,
+                     size_t gap, size_t pos) {
+    char *b = (char *)base;
+    size_t gl = cap - n;
+    if (pos < gap)
+        memmove(b + (pos + gl) * sz, b + pos * sz, (gap - pos) * sz);
+    else if (pos > gap)
+        memmove(b + gap * sz, b + (gap + gl) * sz, (pos - gap) * sz);
+}
+
+/* gap_cap:
+   Slots for an array of n elements with room for need more. */
+static size_t gap_cap(size_t cap, size_t n, size_t need) {
+    size_t nc = cap ? cap : 1024;
+    while (nc - n < need) nc *= 2;
+    return nc;
+}
+
+/* gap_widen:
+   After base was reallocated from cap to nc slots: moves the elements
+   behind the gap to the new end. */
+static void gap_widen(void *base, size_t sz, size_t n, size_t cap, size_t nc,
+                      size_t gap) {
+    size_t tail = n - gap;
+    memmove((char *)base + (nc - tail) * sz, (char *)base + (cap - tail) * sz,
+            tail * sz);
+}
+
+/* text_gap / tok_gap / stmt_gap:
+   Move a gap to pos. Tokens and statements that cross a gap switch
+   between counting from the start and from the end (x -> len - x both
+   ways). */
+static void text_gap(KshDoc *D, size_t pos) {
+    gap_move(D->text, 1, D->len, D->cap, D->gap, pos);
+    D->gap = pos;
+}
+
+static void tok_gap(KshDoc *D, size_t pos) {
+    size_t lo = pos < D->tgap ? pos : D->tgap;
+    size_t hi = pos < D->tgap ? D->tgap : pos;
+    size_t gl = D->captok - D->ntok;
+    gap_move(D->kind, 1, D->ntok, D->captok, D->tgap, pos);
+    gap_move(D->sym, 1, D->ntok, D->captok, D->tgap, pos);
+    gap_move((void *)D->lex, sizeof(const char *), D->ntok, D->captok, D->tgap, pos);
+    gap_move(D->span, sizeof(DocSpan), D->ntok, D->captok, D->tgap, pos);
+    D->tgap = pos;
+    for (size_t i = lo; i < hi; i++) {
+        DocSpan *s = &D->span[i < pos ? i : i + gl];
+        s->off = (uint32_t)(D->len - s->off);
+        s->end = (uint32_t)(D->len - s->end);
+    }
+}
+
+static void stmt_gap(KshDoc *D, size_t pos) {
+    size_t lo = pos < D->sgap ? pos : D->sgap;
+    size_t hi = pos < D->sgap ? D->sgap : pos;
+    size_t gl = D->capstmt - D->nstmt;
+    gap_move(D->stmt, sizeof(DocStmt), D->nstmt, D->capstmt, D->sgap, pos);
+    D->sgap = pos;
+    for (size_t i = lo; i < hi; i++) {
+        DocStmt *s = &D->stmt[i < pos ? i : i + gl];
+        s->first = (int)D->ntok - s->first;
+    }
+}
+
+/* text_room / tok_room / stmt_room:
+   Make the gap at least need slots wide. Return 0 when out of memory
+   (the array is unchanged then). */
+static int text_room(KshDoc *D, size_t need) {
+    if (D->cap - D->len >= need) return 1;
+    size_t nc = gap_cap(D->cap, D->len, need);
+    char *p = (char *)realloc(D->text, nc);
+    if (!p) return 0;
+    gap_widen(p, 1, D->len, D->cap, nc, D->gap);
+    D->text = p;
+    D->cap = nc;
+    return 1;
+}
+
+static int tok_room(KshDoc *D, size_t need) {
+    if (D->captok - D->ntok >= need) return 1;
+    size_t nc = gap_cap(D->captok, D->ntok, need);
+    void *p;
+    /* each array is bigger, with the same layout so far */
+    if (!(p = realloc(D->kind, nc))) return 0;
+    D->kind = (uint8_t *)p;
+    if (!(p = realloc(D->sym, nc))) return 0;
+    D->sym = (uint8_t *)p;
+    if (!(p = realloc((void *)D->lex, nc * sizeof(const char *)))) return 0;
+    D->lex = (const char **)p;
+    if (!(p = realloc(D->span, nc * sizeof(DocSpan)))) return 0;
+    D->span = (DocSpan *)p;
+    gap_widen(D->kind, 1, D->ntok, D->captok, nc, D->tgap);
+    gap_widen(D->sym, 1, D->ntok, D->captok, nc, D->tgap);
+    gap_widen((void *)D->lex, sizeof(const char *), D->ntok, D->captok, nc, D->tgap);
+    gap_widen(D->span, sizeof(DocSpan), D->ntok, D->captok, nc, D->tgap);
+    D->captok = nc;
+    return 1;
+}
+
+static int stmt_room(KshDoc *D, size_t need) {
+    if (D->capstmt - D->nstmt >= need) return 1;
+    size_t nc = gap_cap(D->capstmt, D->nstmt, need);
+    DocStmt *p = (DocStmt *)realloc(D->stmt, nc * sizeof(DocStmt));
+    if (!p) return 0;
+    gap_widen(p, sizeof(DocStmt), D->nstmt, D->capstmt, nc, D->sgap);
+    D->stmt = p;
+    D->capstmt = nc;
+    return 1;
+}
+
+/* tok_at / span_off / span_end / stmt_at / stmt_first:
+   Element i, wherever the gap is (for tokens: its slot in the token
+   arrays). */
+static size_t tok_at(const KshDoc *D, size_t i) {
+    return i < D->tgap ? i : i + D->captok - D->ntok;
+}
+
+static size_t span_off(const KshDoc *D, size_t i) {
+    if (i < D->tgap) return D->span[i].off;
+    return D->len - D->span[i + D->captok - D->ntok].off;
+}
+
+static size_t span_end(const KshDoc *D, size_t i) {
+    if (i < D->tgap) return D->span[i].end;
+    return D->len - D->span[i + D->captok - D->ntok].end;
+}
+
+static DocStmt *stmt_at(const KshDoc *D, size_t i) {
+    return &D->stmt[i < D->sgap ? i : i + D->capstmt - D->nstmt];
+}
+
+static int stmt_first(const KshDoc *D, size_t i) {
+    if (i < D->sgap) return D->stmt[i].first;
+    return (int)D->ntok - D->stmt[i + D->capstmt - D->nstmt].first;
+}
+
+/* ---------------- document state ---------------- */
+
+/* doc_bind / doc_unbind:
+   Lend the tokens from index from on and the node pool to the parser,
+   and take them back (the pool may have grown). The token gap is moved
+   to from if it is behind it, so the parser sees one plain array. */
+static void doc_bind(KshDoc *D, size_t from) {
+    if (D->tgap > from) tok_gap(D, from);
+    g_tok_kind = D->kind + (D->captok - D->ntok); /* right for i >= tgap */
+    g_tok_sym = D->sym + (D->captok - D->ntok);
+    g_tok_text = D->lex + (D->captok - D->ntok);
+    g_tok_count = g_tok_cap = (int)D->ntok;
+    g_tok_index = (int)from;
+    g_pull = NULL;
+    g_ast_pool = D->nodes;
+    g_ast_root = NULL;
+    g_open_count = 0;
+    g_ast_oom = 0;
+}
+
+static void doc_unbind(KshDoc *D) {
+    D->nodes = g_ast_pool;
+    g_ast_pool.head = NULL;
+    g_tok_kind = g_tok_sym = NULL;
+    g_tok_text = NULL;
+    g_tok_count = g_tok_cap = g_tok_index = 0;
+    g_ast_root = NULL;
+}
+
+/* doc_on_error:
+   g_error_hook while a document parses: keeps the error for the
+   statement instead of printing it. */
+static void doc_on_error(void *ctx, const char *msg, int tok) {
+    DiagRun *R = (DiagRun *)ctx;
+    if (!grow((void **)&R->diag, &R->cap, R->n, 1, sizeof(DocDiag))) {
+        R->oom = 1;
+        return;
+    }
+    R->diag[R->n].rel = tok - R->first;
+    R->diag[R->n].msg = msg;
+    R->n++;
+}
+
+/* doc_clear:
+   Drop tokens, statements and pools; the text stays. */
+static void doc_clear(KshDoc *D) {
+    for (size_t i = 0; i < D->nstmt; i++)
+        free(stmt_at(D, i)->diag);
+    D->nstmt = D->sgap = 0;
+    D->ntok = D->tgap = 0;
+    D->root = NULL;
+    D->garbage = 0;
+    ksh_intern_free(&D->texts);
+    ksh_pool_free(&D->nodes);
+}
+
+/* doc_close:
+   Free everything. */
+static void doc_close(KshDoc *D) {
+    doc_clear(D);
+    free(D->text);
+    free(D->kind);
+    free(D->sym);
+    free((void *)D->lex);
+    free(D->span);
+    free(D->stmt);
+    memset(D, 0, sizeof *D);
+}
+
+/* doc_text:
+   The whole text in one piece (moves the text gap to the end). */
+static const char *doc_text(KshDoc *D) {
+    text_gap(D, D->len);
+    return D->text;
+}
+
+/* ---------------- re-lexing ---------------- */
+
+/* tok_run_add:
+   Appends t (scanned from [t->off, end)) as a parser token; its text is
+   interned in D->texts. Returns 0 when out of memory. */
+static int tok_run_add(KshDoc *D, TokRun *R, const Token *t, size_t end) {
+    if (!grow((void **)&R->tok, &R->cap, R->n, 1, sizeof(ParserToken)) ||
+        !grow((void **)&R->span, &R->capspan, R->n, 1, sizeof(DocSpan)))
+        return 0;
+    ParserToken *p = &R->tok[R->n];
+    if (t->type == TOK_EOF) {
+        set_eof(p);
+    } else {
+        int n;
+        const char *text = token_text(t, &n);
+        p->kind = map_type(t->type);
+        p->sym = t->sym;
+        if (!(p->lexeme = ksh_intern_str(&D->texts, text, (size_t)n)))
+            return 0;
+    }
+    R->span[R->n].off = (uint32_t)t->off;
+    R->span[R->n].end = (uint32_t)end;
+    R->n++;
+    return 1;
+}
+
+/* doc_relex:
+   The text has had [off, off + del) replaced by ins bytes; the tokens
+   from a on (all behind the token gap) are still those of the old
+   text. Lexes the new tokens into R, from the end of token a - 1, and
+   sets *b to the first old token that is still right. Returns 0 when
+   out of memory. */
+static int doc_relex(KshDoc *D, size_t off, size_t ins, size_t a,
+                     size_t *b, TokRun *R) {
+    size_t start = a ? span_end(D, a - 1) : 0;
+    text_gap(D, start);                 /* start..len in one piece       */
+
+    Lexer L;
+    memset(&L, 0, sizeof L);
+    L.buf = D->text + (D->cap - D->len);  /* right for offsets >= start */
+    L.len = D->len;
+    L.pos = start;
+    L.line = 1;
+    L.lazy_pos = 1;                     /* spans are offsets only        */
+    L.scan = select_kernels();
+
+    /* an old token is intact if it starts at or after the inserted
+       text: at most that far from the end */
+    const DocSpan *old = D->span + (D->captok - D->ntok);
+    size_t intact = D->len - (off + ins);
+    size_t o = a;
+    R->n = 0;
+    for (;;) {
+        Token t = next_token(&L);
+
+        /* same start as an intact old token: the rest is the same */
+        while (o < D->ntok && (old[o].off > intact ||
+                               D->len - old[o].off < t.off))
+            o++;
+        if (o < D->ntok && D->len - old[o].off == t.off)
+            break;
+
+        if (!tok_run_add(D, R, &t, L.pos))
+            return 0;
+        if (t.type == TOK_EOF) {        /* old tail replaced (or no tokens) */
+            o = D->ntok;
+            break;
+        }
+    }
+    *b = o;
+    return 1;
+}
+
+/* doc_splice_tokens:
+   Replaces tokens [a, b) by R; the token gap is at a. Returns 0 when
+   out of memory. */
+static int doc_splice_tokens(KshDoc *D, size_t a, size_t b, const TokRun *R) {
+    D->ntok -= b - a;                   /* they join the gap             */
+    D->garbage += b - a;
+    if (!tok_room(D, R->n))
+        return 0;
+    for (size_t k = 0; k < R->n; k++) {
+        D->kind[a + k] = (uint8_t)R->tok[k].kind;
+        D->sym[a + k] = (uint8_t)R->tok[k].sym;
+        D->lex[a + k] = R->tok[k].lexeme;
+    }
+    if (R->n)
+        memcpy(D->span + a, R->span, R->n * sizeof(DocSpan));
+    D->ntok += R->n;
+    D->tgap = a + R->n;
+    return 1;
+}
+
+/* ---------------- re-parsing ---------------- */
+
+/* doc_parse_stmt:
+   Parses the top-level statement at g_tok_index into S (the document
+   is bound). Returns 0 when out of memory. */
+static int doc_parse_stmt(DocStmt *S, DiagRun *E) {
+    S->first = S->built = g_tok_index;
+    E->n = 0;
+    E->first = g_tok_index;
+    g_ast_root = NULL;
+    g_open_count = 0;
+    parse_statement();
+    S->ntok = g_tok_index - S->first;
+    S->node = g_ast_root;
+    S->diag = NULL;
+    S->ndiag = (int)E->n;
+    if (E->n) {
+        S->diag = (DocDiag *)malloc(E->n * sizeof(DocDiag));
+        if (!S->diag) return 0;
+        memcpy(S->diag, E->diag, E->n * sizeof(DocDiag));
+    }
+    return !g_ast_oom && !E->oom && S->node;
+}
+
+/* doc_reparse:
+   Tokens [a, a + m) are new. Statements from i on (all behind the
+   statement gap) are still those of the old tokens; statement i
+   started at token start. Parses from there until the statements are
+   the old ones again and splices the new ones in. Returns 0 when out
+   of memory. */
+static int doc_reparse(KshDoc *D, size_t i, size_t start, size_t a, size_t m) {
+    StmtRun R = {0};
+    DiagRun E = {0};
+    int ok = 1;
+
+    /* an old statement is intact if it starts at or after the new
+       tokens: at most that far from the end */
+    size_t intact = D->ntok - (a + m);
+    size_t j = i;
+
+    tok_gap(D, start);                  /* new tokens behind the gap too */
+    doc_bind(D, start);
+    g_error_hook = doc_on_error;
+    g_error_ctx = &E;
+
+    while (cur_kind() != PT_EOF) {
+        /* an intact old statement starts here: the rest of the old
+           list is still right */
+        const DocStmt *old = D->stmt + (D->capstmt - D->nstmt);
+        size_t at = (size_t)g_tok_index;
+        while (j < D->nstmt && ((size_t)old[j].first > intact ||
+                                D->ntok - (size_t)old[j].first < at))
+            j++;
+        if (j < D->nstmt && D->ntok - (size_t)old[j].first == at)
+            break;
+
+        if (!grow((void **)&R.stmt, &R.cap, R.n, 1, sizeof(DocStmt))) {
+            ok = 0;
+            break;
+        }
+        if (!doc_parse_stmt(&R.stmt[R.n++], &E)) {
+            ok = 0;
+            break;
+        }
+    }
+    if (ok && cur_kind() == PT_EOF)
+        j = D->nstmt;                   /* parsed to the end            */
+
+    g_error_hook = NULL;
+    g_error_ctx = NULL;
+    doc_unbind(D);
+    free(E.diag);
+
+    if (ok) {                           /* old [i, j) join the gap      */
+        for (size_t k = i; k < j; k++) {
+            DocStmt *s = stmt_at(D, k);
+            D->garbage += (size_t)s->ntok;      /* about one node each  */
+            free(s->diag);
+        }
+        D->nstmt -= j - i;
+        ok = stmt_room(D, R.n);
+    }
+    if (!ok) {
+        for (size_t k = 0; k < R.n; k++) free(R.stmt[k].diag);
+        free(R.stmt);
+        return 0;
+    }
+
+    if (R.n) memcpy(D->stmt + i, R.stmt, R.n * sizeof(DocStmt));
+    D->nstmt += R.n;
+    D->sgap = i + R.n;
+    D->reparsed = R.n;
+    free(R.stmt);
+    return 1;
+}
+
+/* ---------------- opening and editing ---------------- */
+
+/* doc_update:
+   The text changed at [off, off + ins) (ins bytes where there were
+   del); brings tokens and statements up to date. Returns 0 when out of
+   memory. */
+static int doc_update(KshDoc *D, size_t off, size_t del, size_t ins) {
+    size_t new_len = D->len, lo, hi;
+    D->len = new_len - ins + del;       /* the old spans need the old length */
+
+    /* a = tokens that end before the edit (the ends only grow) */
+    lo = 0;
+    hi = D->ntok;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (span_end(D, mid) < off) lo = mid + 1; else hi = mid;
+    }
+    size_t a = lo;
+
+    /* i = first statement that looked at token a or later: its last
+       look is the token right after it */
+    lo = 0;
+    hi = D->nstmt;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((size_t)(stmt_first(D, mid) + stmt_at(D, mid)->ntok) < a) lo = mid + 1;
+        else hi = mid;
+    }
+    size_t i = lo;
+    size_t start = i < D->nstmt ? (size_t)stmt_first(D, i) : 0;
+
+    tok_gap(D, a);                      /* old tail: distances to the end */
+    stmt_gap(D, i);
+    D->len = new_len;
+
+    size_t b;
+    TokRun R = {0};
+    int ok = doc_relex(D, off, ins, a, &b, &R) &&
+             doc_splice_tokens(D, a, b, &R) &&
+             doc_reparse(D, i, start, a, R.n);
+    D->relexed = R.n;
+    free(R.tok);
+    free(R.span);
+    return ok;
+}
+
+/* doc_rebuild:
+   Lexes and parses the whole text again. Returns 0 when out of memory. */
+static int doc_rebuild(KshDoc *D) {
+    doc_clear(D);
+    int ok = doc_update(D, 0, 0, D->len);
+    D->garbage = 0;
+    if (ok && !(D->root = (AstNode *)ksh_pool_alloc(&D->nodes, sizeof(AstNode))))
+        ok = 0;
+    if (!ok) {
+        doc_clear(D);
+        return 0;
+    }
+    D->root->kind = AST_PROGRAM;
+    D->root->tok = 0;
+    D->root->child = D->root->next = NULL;
+    return 1;
+}
+
+/* doc_open:
+   A document with a copy of text[0..len). Returns 0 when out of memory
+   (D is then empty). */
+static int doc_open(KshDoc *D, const char *text, size_t len) {
+    memset(D, 0, sizeof *D);
+    if (len > 0xFFFFFFF0u)              /* spans are 32 bit                 */
+        return 0;
+    if (!text_room(D, len + 1))
+        return 0;
+    if (len) memcpy(D->text, text, len);
+    D->len = D->gap = len;
+    if (!doc_rebuild(D)) {
+        doc_close(D);
+        return 0;
+    }
+    return 1;
+}
+
+/* doc_edit:
+   Replaces text[off, off + del) by ins[0..n) and brings tokens and tree
+   up to date. Returns 1 on success, 0 if the range is outside the text
+   (nothing changed) or memory ran out (the document is empty then). */
+static int doc_edit(KshDoc *D, size_t off, size_t del, const char *ins, size_t n) {
+    if (off > D->len || del > D->len - off ||
+        D->len - del + n > 0xFFFFFFF0u)
+        return 0;
+    if (!text_room(D, n > del ? n - del : 0))
+        return 0;
+    text_gap(D, off);
+    D->len -= del;                      /* deleted bytes join the gap    */
+    if (n) memcpy(D->text + off, ins, n);
+    D->len += n;
+    D->gap = off + n;
+
+    int ok;
+    if (D->garbage > D->ntok + DOC_SLACK) {   /* pools are mostly dead */
+        ok = doc_rebuild(D);
+    } else {
+        ok = doc_update(D, off, del, n);
+        if (!ok) doc_clear(D);
+    }
+    return ok;
+}
+
+/* ---------------- results ---------------- */
+
+static void shift_enter(void *ctx, const AstNode *n, const AstNode *parent) {
+    (void)parent;
+    ((AstNode *)n)->tok += *(const int *)ctx;   /* the document's own nodes */
+}
+
+/* shift_nodes:
+   Adds d to the token index of n and everything under it. Returns 0
+   when out of memory. */
+static int shift_nodes(AstNode *n, int d) {
+    AstVisitor v = { shift_enter, NULL, &d };
+    return ast_walk(n, NULL, &v);
+}
+
+/* doc_tree:
+   The AST_PROGRAM node of the current text, with statements that moved
+   brought up to date. Valid until the next edit; NULL when out of
+   memory. */
+static AstNode *doc_tree(KshDoc *D) {
+    AstNode **link = &D->root->child;
+    for (size_t i = 0; i < D->nstmt; i++) {
+        DocStmt *S = stmt_at(D, i);
+        int first = stmt_first(D, i);
+        if (first != S->built) {
+            S->node->next = NULL;       /* only this statement's nodes  */
+            if (!shift_nodes(S->node, first - S->built))
+                return NULL;
+            S->built = first;
+        }
+        *link = S->node;
+        link = &S->node->next;
+    }
+    *link = NULL;
+    return D->root;
+}
+
+/* doc_errors:
+   Number of syntax errors in the current text. */
+static size_t doc_errors(const KshDoc *D) {
+    size_t n = 0;
+    for (size_t i = 0; i < D->nstmt; i++)
+        n += (size_t)stmt_at(D, i)->ndiag;
+    return n;
+}
+
+/* doc_report:
+   Prints what syntax_run prints for the current text: the errors, the
+   tree (see g_tree_format) and the verdict. Returns 1 if the tree could
+   not be written. */
+static int doc_report(KshDoc *D) {
+    for (size_t i = 0; i < D->nstmt; i++) {
+        const DocStmt *S = stmt_at(D, i);
+        int first = stmt_first(D, i);
+        for (int k = 0; k < S->ndiag; k++) {
+            const char *near = D->lex[tok_at(D, (size_t)(first + S->diag[k].rel))];
+            fprintf(stderr, "[Syntax Error] %s. Near: %s\n",
+                    S->diag[k].msg, near[0] ? near : "(EOF)");
+        }
+    }
+
+    AstNode *root = doc_tree(D);
+    if (!root) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+    doc_bind(D, 0);                     /* the printers read the tokens  */
+    int written = emit_tree(root);
+    doc_unbind(D);
+
+    if (doc_errors(D)) {
+        printf("\n[Syntax] Program has syntax errors.\n");
+    } else {
+        printf("\n[Syntax] Program is syntactically correct.\n");
+    }
+    return !written;
+}
+
+/* ---------------- --check ---------------- */
+
+/* same_nodes:
+   1 if the two sibling lists and everything under them are equal, 0 if
+   not, -1 when out of memory. The lists still to compare are kept on
+   the heap: trees can be deeper than the C stack. */
+static int same_nodes(const AstNode *x, const AstNode *y) {
+    const AstNode **todo = NULL;        /* pairs of sibling lists */
+    size_t n = 0, cap = 0;
+    int same = 1;
+    for (;;) {
+        for (; same && x && y; x = x->next, y = y->next) {
+            if (x->kind != y->kind || x->tok != y->tok)
+                same = 0;
+            else if (x->child || y->child) {
+                if (!grow((void **)&todo, &cap, n, 2, sizeof(*todo))) {
+                    same = -1;
+                    break;
+                }
+                todo[n++] = x->child;
+                todo[n++] = y->child;
+            }
+        }
+        if (same == 1 && (x || y))
+            same = 0;
+        if (same != 1 || n == 0)
+            break;
+        y = todo[--n];
+        x = todo[--n];
+    }
+    ksh_stats_mem(cap * sizeof(*todo), 0);
+    free(todo);
+    return same;
+}
+
+/* doc_check:
+   Lexes and parses the text of D from scratch and compares. Returns
+   1 if D is the same as the fresh result (or memory ran out for it),
+   else prints the first difference and returns 0. */
+static int doc_check(KshDoc *D) {
+    KshDoc F;
+    if (!doc_open(&F, doc_text(D), D->len))
+        return 1;
+
+    int ok = 1;
+    size_t i;
+    if (F.ntok != D->ntok) {
+        fprintf(stderr, "[Check] %zu tokens, %zu from scratch\n", D->ntok, F.ntok);
+        ok = 0;
+    }
+    for (i = 0; ok && i < D->ntok; i++) {
+        size_t x = tok_at(D, i), y = tok_at(&F, i);
+        if (D->kind[x] != F.kind[y] || D->sym[x] != F.sym[y] ||
+            strcmp(D->lex[x], F.lex[y]) != 0 ||
+            span_off(D, i) != span_off(&F, i) || span_end(D, i) != span_end(&F, i)) {
+            fprintf(stderr, "[Check] token %zu differs: '%s' at %zu, '%s' at %zu from scratch\n",
+                    i, D->lex[x], span_off(D, i), F.lex[y], span_off(&F, i));
+            ok = 0;
+        }
+    }
+    if (ok && F.nstmt != D->nstmt) {
+        fprintf(stderr, "[Check] %zu statements, %zu from scratch\n", D->nstmt, F.nstmt);
+        ok = 0;
+    }
+    for (i = 0; ok && i < D->nstmt; i++) {
+        const DocStmt *x = stmt_at(D, i), *y = stmt_at(&F, i);
+        int fx = stmt_first(D, i), fy = stmt_first(&F, i);
+        ok = fx == fy && x->ntok == y->ntok && x->ndiag == y->ndiag;
+        for (int k = 0; ok && k < x->ndiag; k++)
+            ok = x->diag[k].rel == y->diag[k].rel && x->diag[k].msg == y->diag[k].msg;
+        if (!ok)
+            fprintf(stderr, "[Check] statement %zu differs (tokens %d..%d, %d..%d from scratch)\n",
+                    i, fx, fx + x->ntok, fy, fy + y->ntok);
+    }
+    AstNode *tx = ok ? doc_tree(D) : NULL, *ty = ok ? doc_tree(&F) : NULL;
+    if (tx && ty && same_nodes(tx, ty) == 0) {  /* -1: memory ran out */
+        fprintf(stderr, "[Check] syntax trees differ\n");
+        ok = 0;
+    }
+
+    doc_close(&F);
+    return ok;
+}
+
+/* ---------------- edit script ---------------- */
+
+/* read_edit:
+   Parses "OFFSET DELETE TEXT" from line into *off, *del and text (escapes
+   decoded, n bytes). Returns 0 if the line is not an edit. */
+static int read_edit(const char *line, size_t *off, size_t *del,
+                     char *text, size_t *n) {
+    char *e;
+    *off = (size_t)strtoul(line, &e, 10);
+    if (e == line) return 0;
+    line = e;
+    *del = (size_t)strtoul(line, &e, 10);
+    if (e == line) return 0;
+    line = e;
+    if (*line == ' ') line++;           /* one separator before TEXT    */
+
+    size_t k = 0;
+    for (; *line && *line != '\n' && *line != '\r'; line++) {
+        char c = *line;
+        if (c == '\\' && line[1]) {
+            line++;
+            c = *line == 'n' ? '\n' : *line == 't' ? '\t' : *line;
+        }
+        text[k++] = c;
+    }
+    *n = k;
+    return 1;
+}
+
+/* ---------------- main ---------------- */
+
+#define EDIT_LINE_MAX 4096
+
+int main(int argc, char **argv) {
+    const char *path = NULL, *edits = NULL;
+    int check = 0;
+
+    for (int a = 1; a < argc; a++) {
+        int r;
+        if (same_str(argv[a], "--check")) check = 1;
+        else if ((r = tree_option(argv[a])) < 0) {
+            fprintf(stderr, "Error: unknown tree format: %s\n", argv[a]);
+            return 1;
+        }
+        else if (r == 1) continue;
+        else if (!path) path = argv[a];
+        else if (!edits) edits = argv[a];
+    }
+
+    if (!path || !ends_with_ksh(path)) {
+        fprintf(stderr, "usage: ksharp_incremental [--check] [--no-tree | --tree=xml|json|bin]"
+                        " file.ksh [edits | -]\n");
+        return 1;
+    }
+
+    Source src = {0};
+    if (!load_source(path, &src)) {
+        fprintf(stderr, "Error: cannot read file: %s\n", path);
+        return 1;
+    }
+    KshDoc D;
+    int ok = doc_open(&D, src.data, src.len);
+    release_source(&src);
+    if (!ok) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    int status = 0;
+    FILE *in = NULL;
+    if (edits) {
+        in = same_str(edits, "-") ? stdin : fopen(edits, "rb");
+        if (!in) {
+            fprintf(stderr, "Error: cannot read edits: %s\n", edits);
+            doc_close(&D);
+            return 1;
+        }
+    }
+
+    static char line[EDIT_LINE_MAX], text[EDIT_LINE_MAX];
+    int count = 0;
+    while (in && fgets(line, sizeof line, in)) {
+        size_t off, del, n;
+        if (line[0] == '#' || !read_edit(line, &off, &del, text, &n))
+            continue;
+        count++;
+        if (off > D.len || del > D.len - off) {
+            fprintf(stderr, "Error: edit %d is outside the text (%zu bytes)\n",
+                    count, D.len);
+            status = 1;
+            break;
+        }
+        if (!doc_edit(&D, off, del, text, n)) {
+            fprintf(stderr, "Error: out of memory\n");
+            status = 1;
+            break;
+        }
+        printf("[Edit %d] @%zu -%zu +%zu: relexed %zu of %zu tokens,"
+               " reparsed %zu of %zu statements\n",
+               count, off, del, n, D.relexed, D.ntok, D.reparsed, D.nstmt);
+        if (check && !doc_check(&D)) {
+            fprintf(stderr, "[Check] edit %d: incremental result differs\n", count);
+            status = 1;
+            break;
+        }
+    }
+    if (in && in != stdin) fclose(in);
+
+    if (!status && doc_report(&D))
+        status = 1;
+
+    doc_close(&D);
+    ast_free();                  /* the parser's construct stack */
+    return status;
+}
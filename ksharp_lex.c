@@ -0,0 +1,156 @@
+/* ksharp_lex.c
+   The library behind ksharp_lex.h: the lexer of KSHARP2.0.C (compiled
+   in without its main()) behind an opaque handle.
+
+   A KshLexer is a Lexer plus the text it reads. The scanners keep all
+   their state in the Lexer, the token DFA is code and the character
+   classes a constant table, and the scan kernels are picked once per lexer,
+   so two lexers never touch the same memory. The library is built with
+   KSH_NO_STATS: the --stats counters are the only globals the lexer
+   writes to. */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* the lexer tool's table and file code is unused here */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+#include "ksharp_lex.h"
+
+struct KshLexer {
+    Lexer lex;
+    Source src;                  /* the text                              */
+    int owned;                   /* 1 = src is ours to release            */
+    int done;                    /* the TOK_EOF token has been returned   */
+    int streaming;               /* 1 = reads stream, not lex             */
+    LexStream stream;            /* the window over a FILE                */
+    Arena arena;                 /* stream: texts of the last call        */
+};
+
+/* lexer_new:
+   A lexer over data[0..len); owned says whether src goes with it. */
+static KshLexer *lexer_new(const Source *src, int owned, unsigned flags) {
+    KshLexer *L = (KshLexer *)calloc(1, sizeof *L);
+    if (!L) return NULL;
+    L->src = *src;
+    L->owned = owned;
+    L->lex.buf = src->data;
+    L->lex.len = src->len;
+    L->lex.line = 1;
+    L->lex.lazy_pos = (flags & KSH_LEX_NO_POS) != 0;
+    L->lex.scan = select_kernels();
+    return L;
+}
+
+KshLexer *ksh_lexer_open_buffer(const char *buf, size_t len, unsigned flags) {
+    Source src = {0};
+    if (!buf && len) return NULL;
+    if (!(flags & KSH_LEX_COPY)) {
+        src.data = buf ? buf : "";
+        src.len = len;
+        return lexer_new(&src, 0, flags);
+    }
+    char *copy = (char *)malloc(len + 1);
+    if (!copy) return NULL;
+    ksh_stats_mem(0, len + 1);
+    if (len) memcpy(copy, buf, len);
+    copy[len] = 0;
+    src.data = copy;
+    src.len = len;
+    KshLexer *L = lexer_new(&src, 1, flags);
+    if (!L) release_source(&src);
+    return L;
+}
+
+KshLexer *ksh_lexer_open_file(const char *path, unsigned flags) {
+    Source src = {0};
+    if (!path || !load_source(path, &src)) return NULL;
+    KshLexer *L = lexer_new(&src, 1, flags);
+    if (!L) release_source(&src);
+    return L;
+}
+
+KshLexer *ksh_lexer_open_stream(FILE *in, size_t window, unsigned flags) {
+    if (!in) return NULL;
+    KshLexer *L = (KshLexer *)calloc(1, sizeof *L);
+    if (!L) return NULL;
+    if (!stream_open(&L->stream, in, window, (flags & KSH_LEX_NO_POS) != 0, select_kernels())) {
+        free(L);
+        return NULL;
+    }
+    L->streaming = 1;
+    L->stream.lex.arena = &L->arena;   /* the window moves under the texts */
+    return L;
+}
+
+/* lexer_step:
+   The next token of either kind of lexer. */
+static Token lexer_step(KshLexer *L) {
+    return L->streaming ? stream_next(&L->stream) : next_token(&L->lex);
+}
+
+/* put_token:
+   t as the library hands it out; the lexer has just scanned it. */
+static void put_token(const KshLexer *L, const Token *t, KshToken *out) {
+    size_t end = L->streaming ? L->stream.base + L->stream.lex.pos : L->lex.pos;
+    int n;
+    out->text = token_text(t, &n);
+    out->len = (size_t)n;
+    out->type = t->type;
+    out->sym = t->sym;
+    out->off = t->off;
+    out->size = end - t->off;
+    out->line = (uint32_t)t->line;
+    out->col = (uint32_t)t->col;
+}
+
+int ksh_lexer_next(KshLexer *L, KshToken *tok) {
+    if (L->streaming) arena_reset(&L->arena);
+    Token t = lexer_step(L);         /* at the end it keeps making EOF */
+    put_token(L, &t, tok);
+    if (t.type == TOK_EOF) {
+        L->done = 1;
+        return 0;
+    }
+    return 1;
+}
+
+size_t ksh_lexer_fill(KshLexer *L, KshToken *out, size_t max) {
+    size_t n = 0;
+    if (L->streaming) arena_reset(&L->arena);
+    while (n < max && !L->done) {
+        Token t = lexer_step(L);
+        if (t.type == TOK_EOF) {
+            L->done = 1;
+            break;
+        }
+        put_token(L, &t, &out[n++]);
+    }
+    return n;
+}
+
+int ksh_lexer_position(KshLexer *L, size_t off, uint32_t *line, uint32_t *col) {
+    int l, c;
+    if (L->streaming || !lexer_position(&L->lex, off, &l, &c)) return 0;
+    *line = (uint32_t)l;
+    *col = (uint32_t)c;
+    return 1;
+}
+
+void ksh_lexer_reset(KshLexer *L) {
+    if (L->streaming) return;        /* what was read is gone */
+    L->lex.pos = L->lex.tok_start = 0;   /* the newline index stays valid */
+    L->lex.line = 1;
+    L->lex.line_start = L->lex.synced = 0;
+    L->done = 0;
+}
+
+void ksh_lexer_close(KshLexer *L) {
+    if (!L) return;
+    line_index_free(&L->lex);
+    if (L->owned) release_source(&L->src);
+    if (L->streaming) {
+        stream_close(&L->stream);
+        arena_free(&L->arena);
+    }
+    free(L);
+}
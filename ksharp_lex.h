@@ -0,0 +1,106 @@
+/* ksharp_lex.h
+   The K# lexer as a library (make -f MakeFile lib -> libksharp_lex.a),
+   for programs that want tokens from a buffer or a file without going
+   through SymbolTable.ktok.
+
+   A KshLexer is one scan of one text. It holds everything the scan
+   needs: the tables it reads are constant, and nothing is shared between
+   lexers, so any number of them can run at once on different threads
+   with no locks. One lexer must not be used by two threads at the same
+   time.
+
+       KshLexer *L = ksh_lexer_open_file("prog.ksh", 0);
+       KshToken t;
+       while (ksh_lexer_next(L, &t))
+           printf("%.*s %s\n", (int)t.len, t.text, ktok_type_name(t.type));
+       ksh_lexer_close(L);
+
+   The tokens are the ones the lexer tool writes to SymbolTable.ktok:
+   same kind, symbol id, text and position. Their text points into the
+   source (or at a static label) and is not '\0'-terminated; it stays
+   valid until the lexer is closed. A string or char literal's text is
+   its body as written, escapes and all; ksh_unescape() gives its value. */
+
+#ifndef KSHARP_LEX_H
+#define KSHARP_LEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "ksharp_tokens.h"   /* TokenType, KtokSym and their names */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct KshLexer KshLexer;
+
+typedef struct {
+    TokenType   type;        /* kind, as in .ktok                          */
+    KtokSym     sym;         /* exact symbol or keyword, KSYM_NONE if none */
+    const char *text;        /* what the table shows: label or source text */
+    size_t      len;         /* bytes in text                              */
+    size_t      off;         /* where the token starts in the source       */
+    size_t      size;        /* bytes of source it covers                  */
+    uint32_t    line, col;   /* 1-based; 0 with KSH_LEX_NO_POS             */
+} KshToken;
+
+/* flags for ksh_lexer_open_buffer / ksh_lexer_open_file */
+enum {
+    KSH_LEX_COPY   = 1,      /* buffer: lex a private copy, so the caller
+                                may free or change buf right away        */
+    KSH_LEX_NO_POS = 2       /* leave line/col 0 (offsets only, faster);
+                                ksh_lexer_position() still answers       */
+};
+
+/* ksh_lexer_open_buffer:
+   A lexer over buf[0..len). Without KSH_LEX_COPY, buf must stay
+   unchanged until the lexer is closed. NULL if out of memory. */
+KshLexer *ksh_lexer_open_buffer(const char *buf, size_t len, unsigned flags);
+
+/* ksh_lexer_open_file:
+   A lexer over the file at path (mapped where possible). NULL if the
+   file cannot be read or memory runs out. */
+KshLexer *ksh_lexer_open_file(const char *path, unsigned flags);
+
+/* ksh_lexer_open_stream:
+   A lexer that reads in as it goes, through a window of about window
+   bytes (0 = 256K) that is refilled as the tokens are used up: for
+   pipes, stdin or a producer that is still writing, and for any input
+   too big to keep. Memory stays at the window (it only grows for a
+   single token longer than that). Token texts are copies, valid until
+   the next ksh_lexer_next/ksh_lexer_fill call; ksh_lexer_position and
+   ksh_lexer_reset do not work on it. in must not have been read from,
+   and stays open. NULL if out of memory. */
+KshLexer *ksh_lexer_open_stream(FILE *in, size_t window, unsigned flags);
+
+/* ksh_lexer_next:
+   The next token into *tok. Returns 1, or 0 at the end of the text, when
+   *tok is the TOK_EOF token (again on every later call). */
+int ksh_lexer_next(KshLexer *L, KshToken *tok);
+
+/* ksh_lexer_fill:
+   Up to max next tokens into out[0..); returns how many. The TOK_EOF
+   token is not stored, so fewer than max means the text is done, and 0
+   that it was already done. */
+size_t ksh_lexer_fill(KshLexer *L, KshToken *out, size_t max);
+
+/* ksh_lexer_position:
+   Line and column (1-based) of byte offset off. Returns 0 if out of
+   memory, or for a stream lexer. */
+int ksh_lexer_position(KshLexer *L, size_t off, uint32_t *line, uint32_t *col);
+
+/* ksh_lexer_reset:
+   Start over at the beginning of the same text (not for a stream). */
+void ksh_lexer_reset(KshLexer *L);
+
+/* ksh_lexer_close:
+   Frees the lexer, and the text if it made or mapped it (a stream's
+   FILE is the caller's to close). NULL is fine. */
+void ksh_lexer_close(KshLexer *L);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KSHARP_LEX_H */
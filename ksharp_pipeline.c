@@ -0,0 +1,179 @@
+/* ksharp_pipeline.c
+   Lexer -> syntax analyzer -> semantic checker in one process.
+
+   The three tools are compiled into this file (each one without its
+   main()), and the parser pulls its tokens straight from next_token():
+   no SymbolTable file, no second tokenizer. The parser and the semantic
+   checker share one copy of every token text.
+
+   Usage:  ksharp_pipeline [--dump] [--stats] [--max-errors=N]
+                           [--no-tree | --tree=xml|json|bin] [file.ksh]
+     --dump   also write SymbolTable.txt and SymbolTable.ktok, exactly as
+              the standalone lexer would (to debug the hand-off)
+     --stats  times, token counts and memory on stderr; the lexer runs
+              inside the parser here, so its time is in "parse"
+     --max-errors=N, --no-tree, --tree=FORMAT
+              as for the syntax analyzer
+
+   Output is what syntax and semantic print when run one after the other
+   on the lexer's files (the semantic header names the .ksh file instead
+   of SymbolTable.ktok). */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* the file loaders of each tool are unused here */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+#include "KSHARP_SYNTAX2.0.c"
+#include "ksharp_semantic.c"
+
+/* ---------------- token source for the parser ---------------- */
+
+typedef struct {
+    Lexer    *lex;     /* the running lexer */
+    int       done;    /* EOF already handed out */
+    TableOut *table;   /* --dump: rows for SymbolTable.txt, else NULL */
+    KtokOut  *ktok;    /* --dump: records for SymbolTable.ktok, else NULL */
+    int       ok;      /* 0 once ktok_add ran out of memory */
+} Pipe;
+
+/* One lexer token -> one parser token (and one semantic token). */
+static int pipe_pull(void *ctx, ParserToken *out) {
+    Pipe *P = (Pipe *)ctx;
+    if (P->done) return 0;
+
+    Token t = next_token(P->lex);
+    int n;
+    const char *text = token_text(&t, &n);   /* label or view, not NUL-ended */
+
+    if (P->table) write_row(P->table, text, n, tname(t.type));
+    if (P->ktok && P->ok && !ktok_add(P->ktok, &t, text, n)) P->ok = 0;
+
+    if (t.type == TOK_EOF) {
+        P->done = 1;
+        set_eof(out);
+        return 1;
+    }
+
+    /* one copy per distinct text, shared: the semantic checker keeps it,
+       the parser reads it */
+    const char *lex = add_token_copy(text, (size_t)n, t.type, t.sym);
+    if (!lex) {
+        P->done = 1;             /* out of memory: end the stream here */
+        P->ok = 0;
+        return 0;
+    }
+    out->kind = map_type(t.type);
+    out->sym = t.sym;
+    out->lexeme = lex;
+    return 1;
+}
+
+/* ---------------- main ---------------- */
+
+int main(int argc, char **argv) {
+    const char *path = "sample.ksh";
+    int dump = 0, stats = 0;
+    g_max_errors = MAX_ERRORS;
+
+    for (int a = 1; a < argc; a++) {
+        int r;
+        if (same_str(argv[a], "--dump")) dump = 1;
+        else if (same_str(argv[a], "--stats")) stats = 1;
+        else if ((r = max_errors_option(argv[a])) != 0) {
+            if (r < 0) {
+                fprintf(stderr, "Error: bad error limit: %s\n", argv[a]);
+                return 1;
+            }
+        }
+        else if ((r = tree_option(argv[a])) < 0) {
+            fprintf(stderr, "Error: unknown tree format: %s\n", argv[a]);
+            return 1;
+        }
+        else if (r == 0) path = argv[a];
+    }
+
+    if (!ends_with_ksh(path)) {
+        fprintf(stderr, "Error: need a .ksh source file (got: %s)\n", path);
+        return 1;
+    }
+
+    Source src = {0};
+    double t = ksh_now();
+    if (!load_source(path, &src)) {
+        fprintf(stderr, "Error: cannot read file: %s\n", path);
+        return 1;
+    }
+    ksh_stats_lap(&ksh_stats, KSH_PH_LOAD, t);
+    ksh_stats.bytes = src.len;
+    ksh_stats.copied = src.mapped ? 0 : src.len;
+
+    Lexer L = {0};
+    L.buf = src.data; L.len = src.len;
+    L.line = 1;
+    L.scan = select_kernels();
+    L.lazy_pos = !dump;          /* positions only go into SymbolTable.ktok */
+
+    TableOut T = {0};
+    KtokOut  K = {0};
+    FILE *out = NULL;
+    Pipe P = {0};
+    P.lex = &L;
+    P.ok = 1;
+
+    if (dump) {
+        out = fopen("SymbolTable.txt", "wb");
+        T.buf = (char *)malloc(TABLE_BUF_SIZE);
+        if (!out || !T.buf) {
+            fprintf(stderr, "Error: cannot create SymbolTable.txt\n");
+            if (out) fclose(out);
+            free(T.buf);
+            release_source(&src);
+            return 1;
+        }
+        T.sink[T.nsink++] = out;
+        write_head(&T, path);
+        P.table = &T;
+        P.ktok = &K;
+    }
+
+    /* stage 2 drives stage 1; stage 3 collects tokens on the way */
+    token_count = 0;
+    if (!parser_set_source(pipe_pull, &P)) {
+        release_source(&src);
+        return 1;
+    }
+    int status = 0;
+    if (syntax_run() == 2)       /* the tree could not be written */
+        status = 1;
+
+    ParserToken rest;            /* parser stopped early: lex the rest too */
+    while (pipe_pull(&P, &rest))
+        ;
+
+    semantic_run(path);
+
+    if (dump) {
+        write_foot(&T);
+        fclose(out);
+        if (!P.ok || !ktok_save(&K, KTOK_FILE)) {
+            fprintf(stderr, "Error: cannot write %s\n", KTOK_FILE);
+            status = 1;
+        }
+    }
+
+    if (!P.ok && !dump) {
+        fprintf(stderr, "Error: out of memory\n");
+        status = 1;
+    }
+    if (stats)
+        ksh_stats_print(stderr);
+
+    free_st_tokens();            /* semantic tokens and their texts */
+    ast_free();                  /* syntax tree */
+    free_tokens();               /* parser tokens */
+    ktok_out_free(&K);
+    free(T.buf);
+    release_source(&src);
+    return status;
+}
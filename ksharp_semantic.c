@@ -1,13 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#include "ksharp_tokens.h"
 
-/* ---------------- Token from SymbolTable.txt ---------------- */
+/* ---------------- Tokens from SymbolTable.ktok / .txt ---------------- */
 
-typedef struct {
-    char lexeme[64];   /* text in the left column */
-    char token[32];    /* text in the right column, e.g. "identifier", "type" */
-} STToken;
+/* One array per field (token i is tok_text[i], tok_type[i], ...). The
+   checks look at type, sym and id, and read a text only to print it.
+   The text is not owned: it points into the loaded .ktok file or into
+   st_names. */
+#define ST_TOK_SLOT (sizeof(const char *) + 2 + sizeof(int))   /* bytes per token */
 
 /* ---------------- Variable type for semantics ---------------- */
 
@@ -19,22 +22,139 @@ typedef enum {
     VT_CHAR
 } VarType;
 
-/* A single variable entry in our semantic symbol table */
+/* A single variable entry in our semantic symbol table: one slot of an
+   open-addressing hash table keyed by (scope, name id). */
 typedef struct {
-    char name[64];   /* variable name */
-    VarType type;    /* its type */
+    int scope;          /* block it is declared in, -1 = empty slot */
+    int name;           /* interned name id */
+    VarType type;       /* its type */
 } VarEntry;
 
-/* Simple fixed-size storage (OK for demo) */
-#define MAX_TOKENS  2000
-#define MAX_VARS    256
-
-STToken tokens[MAX_TOKENS];
+static const char **tok_text = NULL;   /* text in the left column */
+static uint8_t *tok_type = NULL;       /* TokenType */
+static uint8_t *tok_sym = NULL;        /* KtokSym, KSYM_NONE if not a symbol */
+static int *tok_id = NULL;             /* identifiers: id in st_names, else -1 */
 int token_count = 0;
+static int token_cap = 0;
+
+static KshIntern st_names;     /* identifier ids; copied texts, each once */
+static KtokFile ktok_file;    /* loaded SymbolTable.ktok, texts used in place */
 
-VarEntry vars[MAX_VARS];
+/* Block scopes: scope 0 is the file, every '{' opens the next one */
+static int *scope_parent = NULL;
+static int scope_count = 0;
+static int scope_cap = 0;
+
+static VarEntry *vars = NULL;
+static int var_cap = 0;
 int var_count = 0;
 
+/* Assignment messages, printed after the declarations */
+static char *check_log = NULL;
+static size_t check_log_used = 0;
+static size_t check_log_cap = 0;
+
+/* Where the results go; NULL = stdout (a driver may capture them) */
+static FILE *sem_out = NULL;
+
+/* Makes room for cap tokens in every array. Returns 0 when out of
+   memory (arrays that did grow keep their new size). */
+static int tokens_grow(int cap) {
+    void *p;
+    if (!(p = realloc((void *)tok_text, (size_t)cap * sizeof(const char *)))) return 0;
+    tok_text = (const char **)p;
+    if (!(p = realloc(tok_type, (size_t)cap))) return 0;
+    tok_type = (uint8_t *)p;
+    if (!(p = realloc(tok_sym, (size_t)cap))) return 0;
+    tok_sym = (uint8_t *)p;
+    if (!(p = realloc(tok_id, (size_t)cap * sizeof(int)))) return 0;
+    tok_id = (int *)p;
+    ksh_stats_mem((size_t)token_cap * ST_TOK_SLOT, (size_t)cap * ST_TOK_SLOT);
+    token_cap = cap;
+    return 1;
+}
+
+/* ---------------- Append one token ---------------- */
+
+/* Appends one token; id is its name id or -1. Returns 0 when out of
+   memory. */
+static int push_st_token(const char *text, TokenType type, KtokSym sym, int id) {
+    if (token_count == token_cap && !tokens_grow(token_cap ? token_cap * 2 : 1024)) {
+        fprintf(stderr, "Out of memory after %d tokens\n", token_count);
+        return 0;
+    }
+    tok_text[token_count] = text;
+    tok_type[token_count] = (uint8_t)type;
+    tok_sym[token_count]  = (uint8_t)sym;
+    tok_id[token_count]   = id;
+    KSH_STAT(ksh_stats.tokens[type]++);
+    token_count++;
+    return 1;
+}
+
+/* Stores lexeme as it is (the text must outlive the tokens) and interns
+   identifier names. Returns 0 when out of memory. */
+static int add_token(const char *lexeme, TokenType type, KtokSym sym) {
+    int id = -1;
+    if (type == TOK_IDENTIFIER &&
+        (id = ksh_intern_view(&st_names, lexeme, strlen(lexeme))) < 0) {
+        fprintf(stderr, "Out of memory after %d tokens\n", token_count);
+        return 0;
+    }
+    return push_st_token(lexeme, type, sym, id);
+}
+
+/* Like add_token for text[0..n) that does not outlive the call: every
+   distinct text is copied once into st_names, and all its tokens share
+   that copy. Returns the copy, or NULL when out of memory. */
+static const char *add_token_copy(const char *text, size_t n, TokenType type, KtokSym sym) {
+    int id = ksh_intern(&st_names, text, n);
+    if (id < 0) {
+        fprintf(stderr, "Out of memory after %d tokens\n", token_count);
+        return NULL;
+    }
+    const char *lex = ksh_intern_text(&st_names, id, NULL);
+    if (!push_st_token(lex, type, sym, type == TOK_IDENTIFIER ? id : -1)) return NULL;
+    return lex;
+}
+
+static void free_st_tokens(void) {
+    ksh_stats_mem((size_t)token_cap * ST_TOK_SLOT, 0);
+    ksh_stats_mem((size_t)scope_cap * sizeof(int), 0);
+    ksh_stats_mem((size_t)var_cap * sizeof(VarEntry), 0);
+    ksh_stats_mem(check_log_cap, 0);
+    free((void *)tok_text);
+    free(tok_type);
+    free(tok_sym);
+    free(tok_id);
+    tok_text = NULL;
+    tok_type = tok_sym = NULL;
+    tok_id = NULL;
+    token_count = token_cap = 0;
+    ksh_intern_free(&st_names);
+    ktok_free(&ktok_file);
+
+    free(scope_parent);
+    scope_parent = NULL;
+    scope_count = scope_cap = 0;
+    free(vars);
+    vars = NULL;
+    var_cap = var_count = 0;
+    free(check_log);
+    check_log = NULL;
+    check_log_used = check_log_cap = 0;
+}
+
+#ifdef KSHARP_NO_MAIN
+/* Forgets the tokens and names of the last run but keeps the memory,
+   for a driver that checks one text after another. */
+static void reset_st_tokens(void) {
+    token_count = 0;
+    ksh_intern_reset(&st_names);
+    ktok_free(&ktok_file);
+}
+#endif
+
 /* ---------------- Utility: trim newline from strings ---------------- */
 
 static void trim_newline(char *s) {
@@ -56,50 +176,156 @@ static VarType type_from_lexeme(const char *lex) {
     return VT_UNKNOWN;
 }
 
-/* ---------------- Map token name -> VarType for RHS expr ---------------- */
+/* ---------------- Block scopes ---------------- */
+
+/* Scope 0 is the file; each '{' opens a new scope inside the current one.
+   Returns the new scope, or -1 when out of memory. */
+static int new_scope(int parent) {
+    if (scope_count == scope_cap) {
+        int cap = scope_cap ? scope_cap * 2 : 64;
+        int *p = (int *)realloc(scope_parent, (size_t)cap * sizeof(int));
+        if (!p) return -1;
+        ksh_stats_mem((size_t)scope_cap * sizeof(int), (size_t)cap * sizeof(int));
+        scope_parent = p;
+        scope_cap = cap;
+    }
+    scope_parent[scope_count] = parent;
+    return scope_count++;
+}
 
-static VarType type_from_token(const char *token, const char *lexeme) {
-    /* literal constants */
-    if (strcmp(token, "const_int")   == 0) return VT_INT;
-    if (strcmp(token, "const_float") == 0) return VT_FLOAT;
-    if (strcmp(token, "const_bool")  == 0) return VT_BOOL;
-    if (strcmp(token, "const_char")  == 0) return VT_CHAR;
+/* ---------------- Symbol table operations ---------------- */
 
-    /* identifiers: look up in our semantic symbol table */
-    if (strcmp(token, "identifier") == 0) {
-        for (int i = 0; i < var_count; i++) {
-            if (strcmp(vars[i].name, lexeme) == 0) {
-                return vars[i].type;
-            }
-        }
-        /* use before declare -> unknown (will trigger error later) */
-        return VT_UNKNOWN;
-    }
+static unsigned var_hash(int scope, int name) {
+    return ((unsigned)name * 2654435761u) ^ ((unsigned)scope * 40503u);
+}
 
-    /* default */
-    return VT_UNKNOWN;
+/* The slot of (scope, name), or the empty slot where it would go. */
+static VarEntry *var_slot(int scope, int name) {
+    unsigned j = var_hash(scope, name) & (unsigned)(var_cap - 1);
+    while (vars[j].scope != -1 &&
+           (vars[j].scope != scope || vars[j].name != name))
+        j = (j + 1) & (unsigned)(var_cap - 1);
+    return &vars[j];
 }
 
-/* ---------------- Symbol table operations ---------------- */
+/* Doubles the table (starting at 1024 slots). Returns 0 when out of
+   memory. */
+static int var_grow(void) {
+    int cap = var_cap ? var_cap * 2 : 1024;
+    VarEntry *old = vars;
+    int old_cap = var_cap;
+    VarEntry *p = (VarEntry *)malloc((size_t)cap * sizeof(VarEntry));
+    if (!p) return 0;
+    ksh_stats_mem((size_t)old_cap * sizeof(VarEntry), (size_t)cap * sizeof(VarEntry));
+    for (int i = 0; i < cap; i++) p[i].scope = -1;
+    vars = p;
+    var_cap = cap;
+    for (int i = 0; i < old_cap; i++)
+        if (old[i].scope != -1) *var_slot(old[i].scope, old[i].name) = old[i];
+    free(old);
+    return 1;
+}
 
-static int find_var(const char *name) {
-    for (int i = 0; i < var_count; i++) {
-        if (strcmp(vars[i].name, name) == 0) {
-            return i;
-        }
+/* The variable declared in exactly this scope, or NULL. */
+static const VarEntry *find_var_in(int scope, int name) {
+    if (var_cap == 0) return NULL;
+    const VarEntry *v = var_slot(scope, name);
+    return v->scope == -1 ? NULL : v;
+}
+
+/* The variable name refers to from scope: its own block first, then the
+   enclosing ones. NULL if it is not declared in any of them. */
+static const VarEntry *find_var(int scope, int name) {
+    for (; scope != -1; scope = scope_parent[scope]) {
+        const VarEntry *v = find_var_in(scope, name);
+        if (v) return v;
     }
-    return -1;
+    return NULL;
 }
 
-static void add_var(const char *name, VarType t) {
-    if (var_count >= MAX_VARS) return;  /* too many, ignore for demo */
-    strncpy(vars[var_count].name, name, sizeof(vars[var_count].name)-1);
-    vars[var_count].name[sizeof(vars[var_count].name)-1] = '\0';
-    vars[var_count].type = t;
+/* Returns 0 when out of memory. */
+static int add_var(int scope, int name, VarType t) {
+    if (var_count * 2 >= var_cap && !var_grow()) return 0;
+    VarEntry *v = var_slot(scope, name);
+    v->scope = scope;
+    v->name = name;
+    v->type = t;
     var_count++;
+    return 1;
+}
+
+/* ---------------- Map token -> VarType for RHS expr ---------------- */
+
+static VarType type_from_token(int i, int scope) {
+    switch (tok_type[i]) {
+        /* literal constants */
+        case TOK_CONST_INT:   return VT_INT;
+        case TOK_CONST_FLOAT: return VT_FLOAT;
+        case TOK_CONST_BOOL:  return VT_BOOL;
+        case TOK_CONST_CHAR:  return VT_CHAR;
+
+        /* identifiers: look up in our semantic symbol table */
+        case TOK_IDENTIFIER: {
+            const VarEntry *v = find_var(scope, tok_id[i]);
+            /* not declared (yet) -> unknown */
+            return v ? v->type : VT_UNKNOWN;
+        }
+
+        /* default */
+        default: return VT_UNKNOWN;
+    }
+}
+
+/* ---------------- Step 1: read SymbolTable.ktok into the tokens ---------------- */
+
+/* Returns 1 if the binary token stream was loaded, 0 if it is missing or
+   invalid (then the text table is used). Lexemes are the full token text,
+   so strings and comments with spaces are kept as one token. */
+static int load_tokens_ktok(const char *path) {
+    KtokFile *f = &ktok_file;     /* stays loaded: tokens point into it */
+    int rc = ktok_load(path, f);
+    if (rc == 0) return 0;
+    if (rc < 0) {
+        fprintf(stderr, "Ignoring invalid token file %s\n", path);
+        return 0;
+    }
+
+    token_count = 0;
+    for (uint32_t i = 0; i < f->count; i++) {
+        if (f->rec[i].type == TOK_EOF) break;   /* not a table row either */
+        if (!add_token(ktok_text(f, i), (TokenType)f->rec[i].type,
+                       (KtokSym)f->rec[i].sym))
+            return 0;
+    }
+    return 1;
 }
 
-/* ---------------- Step 1: read SymbolTable.txt into tokens[] ---------------- */
+/* ---------------- Step 1b: read SymbolTable.txt into the tokens ---------------- */
+
+/* The table only has the label of a kind ("operator" stands for four of
+   them), so pick the kind from the label and, for symbols, the text. */
+static TokenType type_from_label(const char *label, KtokSym sym) {
+    if (strcmp(label, "identifier")   == 0) return TOK_IDENTIFIER;
+    if (strcmp(label, "keyword")      == 0) return TOK_KEYWORD;
+    if (strcmp(label, "type")         == 0) return TOK_RESERVED_TYPE;
+    if (strcmp(label, "const_int")    == 0) return TOK_CONST_INT;
+    if (strcmp(label, "const_float")  == 0) return TOK_CONST_FLOAT;
+    if (strcmp(label, "const_char")   == 0) return TOK_CONST_CHAR;
+    if (strcmp(label, "const_string") == 0) return TOK_CONST_STRING;
+    if (strcmp(label, "const_bool")   == 0) return TOK_CONST_BOOL;
+    if (strcmp(label, "comment")      == 0) return TOK_COMMENT;
+    if (strcmp(label, "noise")        == 0) return TOK_NOISE;
+    if (strcmp(label, "operator")     == 0) {
+        if (sym == KSYM_ASSIGN) return TOK_ASSIGN;
+        if (ksym_is_rel(sym))   return TOK_OP_REL;
+        if (sym == KSYM_AND || sym == KSYM_OR || sym == KSYM_NOT)
+            return TOK_OP_LOGIC;
+        return TOK_OP_ARITH;
+    }
+    if (strcmp(label, "punctuator")   == 0)
+        return sym >= KSYM_LPAREN ? TOK_BRACKET : TOK_DELIM;
+    return TOK_UNKNOWN;
+}
 
 static int load_tokens(const char *path) {
     FILE *fp = fopen(path, "r");
@@ -119,19 +345,20 @@ static int load_tokens(const char *path) {
         if (line[0] != '|') continue; /* not a table row */
 
         /* Parse: | <lexeme> | <token> | */
-        STToken tok;
-        memset(&tok, 0, sizeof(tok));
-
         /* We assume lexeme and token have no spaces except inside long strings.
            For semantics we only care about identifiers/types/literals/operators,
            so %s parsing is OK. */
         char lex[64], type[32];
         /* note: %63s means "up to 63 non-space characters" */
         if (sscanf(line, "| %63s | %31s |", lex, type) == 2) {
-            strncpy(tok.lexeme, lex, sizeof(tok.lexeme)-1);
-            strncpy(tok.token,  type, sizeof(tok.token)-1);
-            tokens[token_count++] = tok;
-            if (token_count >= MAX_TOKENS) break;
+            KtokSym sym = KSYM_NONE;
+            if (strcmp(type, "operator") == 0 || strcmp(type, "punctuator") == 0 ||
+                strcmp(type, "keyword") == 0)
+                sym = (KtokSym)ksym_lookup(lex);
+            if (!add_token_copy(lex, strlen(lex), type_from_label(type, sym), sym)) {
+                fclose(fp);
+                return 0;
+            }
         }
     }
 
@@ -139,84 +366,152 @@ static int load_tokens(const char *path) {
     return 1;
 }
 
-/* ---------------- Step 2: build semantic symbol table ---------------- */
+/* ---------------- Step 2: declarations and assignments, one pass ---------------- */
+
+/* Appends one formatted message to check_log. Returns 0 when out of memory. */
+static int log_check(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+
+    if (check_log_used + (size_t)n + 1 > check_log_cap) {
+        size_t cap = check_log_cap ? check_log_cap : 4096;
+        while (cap < check_log_used + (size_t)n + 1) cap *= 2;
+        char *p = (char *)realloc(check_log, cap);
+        if (!p) return 0;
+        ksh_stats_mem(check_log_cap, cap);
+        check_log = p;
+        check_log_cap = cap;
+    }
 
-static void build_symbol_table(void) {
-    for (int i = 0; i < token_count; i++) {
-        /* Look for pattern:   type identifier ;  */
-        if (strcmp(tokens[i].token, "type") == 0) {
-            if (i + 1 < token_count && strcmp(tokens[i+1].token, "identifier") == 0) {
-                const char *type_lex = tokens[i].lexeme;
-                const char *name_lex = tokens[i+1].lexeme;
+    va_start(ap, fmt);
+    vsnprintf(check_log + check_log_used, (size_t)n + 1, fmt, ap);
+    va_end(ap);
+    check_log_used += (size_t)n;
+    return 1;
+}
 
-                VarType t = type_from_lexeme(type_lex);
-                int idx = find_var(name_lex);
+/* Checks  identifier = <expr>  at token i. Returns 0 when out of memory. */
+static int check_assignment(int i, int scope) {
+    const char *name_lex = tok_text[i];
 
-                if (idx != -1) {
-                    printf("[Semantic Error] Duplicate declaration of '%s'\n", name_lex);
-                } else {
-                    add_var(name_lex, t);
-                    printf("[Declare] %s %s\n", type_lex, name_lex);
-                }
-            }
-        }
+    /* Find declared type of the variable on the left */
+    const VarEntry *v = find_var(scope, tok_id[i]);
+    if (!v) {
+        return log_check("[Semantic Error] Variable '%s' used before declaration (assignment)\n",
+                         name_lex);
     }
-}
 
-/* ---------------- Step 3: check assignments ---------------- */
+    VarType left_type = v->type;
+    VarType right_type = type_from_token(i + 2, scope);
 
-static void check_assignments(void) {
-    for (int i = 0; i < token_count; i++) {
-        /* Look for pattern: identifier = <expr> ;   */
-        if (strcmp(tokens[i].token, "identifier") == 0) {
-            const char *name_lex = tokens[i].lexeme;
-
-            /* ensure there is '=' and another token after it */
-            if (i + 2 < token_count &&
-                strcmp(tokens[i+1].lexeme, "=") == 0 &&
-                strcmp(tokens[i+1].token,  "operator") == 0) {
-
-                /* Find declared type of the variable on the left */
-                int idx = find_var(name_lex);
-                if (idx == -1) {
-                    printf("[Semantic Error] Variable '%s' used before declaration (assignment)\n",
-                           name_lex);
-                    continue;
-                }
+    if (right_type == VT_UNKNOWN) {
+        return log_check("[Semantic Warning] Cannot determine type of right-hand side for '%s'\n",
+                         name_lex);
+    } else if (left_type != VT_UNKNOWN && left_type != right_type) {
+        return log_check("[Semantic Error] Type mismatch in assignment to '%s' (left is %d, right is %d)\n",
+                         name_lex, left_type, right_type);
+    }
+    return log_check("[OK] Assignment to '%s' is type-safe.\n", name_lex);
+}
 
-                VarType left_type = vars[idx].type;
-                VarType right_type = type_from_token(tokens[i+2].token, tokens[i+2].lexeme);
+/* One forward pass over the tokens:
+     type identifier          declares identifier in the current block
+     identifier = <token>     checks the assignment against what is
+                              declared so far
+     { }                      enter / leave a block
+   Declarations are printed as they are found, assignment results go to
+   check_log. Returns 0 when out of memory. */
+static int analyze(void) {
+    FILE *out = sem_out ? sem_out : stdout;
+    scope_count = 0;            /* forget a previous run */
+    var_count = 0;
+    for (int i = 0; i < var_cap; i++) vars[i].scope = -1;
+    check_log_used = 0;
+
+    int scope = new_scope(-1);
+    if (scope < 0) return 0;
 
-                if (right_type == VT_UNKNOWN) {
-                    printf("[Semantic Warning] Cannot determine type of right-hand side for '%s'\n",
-                           name_lex);
-                } else if (left_type != VT_UNKNOWN && left_type != right_type) {
-                    printf("[Semantic Error] Type mismatch in assignment to '%s' (left is %d, right is %d)\n",
-                           name_lex, left_type, right_type);
+    for (int i = 0; i < token_count; i++) {
+        if (tok_sym[i] == KSYM_LBRACE) {
+            if ((scope = new_scope(scope)) < 0) return 0;
+        } else if (tok_sym[i] == KSYM_RBRACE) {
+            if (scope != 0) scope = scope_parent[scope];   /* unmatched '}': stay */
+        } else if (tok_type[i] == TOK_RESERVED_TYPE) {
+            /* Look for pattern:   type identifier ;  */
+            if (i + 1 < token_count && tok_id[i+1] >= 0) {
+                const char *type_lex = tok_text[i];
+                const char *name_lex = tok_text[i+1];
+
+                if (find_var_in(scope, tok_id[i+1])) {
+                    fprintf(out, "[Semantic Error] Duplicate declaration of '%s'\n", name_lex);
                 } else {
-                    printf("[OK] Assignment to '%s' is type-safe.\n", name_lex);
+                    if (!add_var(scope, tok_id[i+1], type_from_lexeme(type_lex))) return 0;
+                    fprintf(out, "[Declare] %s %s\n", type_lex, name_lex);
                 }
             }
+        } else if (tok_id[i] >= 0) {
+            /* Look for pattern: identifier = <expr> ;   */
+            if (i + 2 < token_count && tok_sym[i+1] == KSYM_ASSIGN &&
+                !check_assignment(i, scope))
+                return 0;
         }
     }
+    return 1;
 }
 
-/* ---------------- main ---------------- */
+/* ---------------- Step 2 on the loaded tokens ---------------- */
+
+static void semantic_run(const char *source) {
+    FILE *out = sem_out ? sem_out : stdout;
+    fprintf(out, "Loaded %d tokens from %s\n\n", token_count, source);
+
+    fprintf(out, "=== Building semantic symbol table ===\n");
+    double t = ksh_now();
+    int ok = analyze();
+    ksh_stats_lap(&ksh_stats, KSH_PH_SEMANTIC, t);
 
-int main(void) {
-    if (!load_tokens("SymbolTable.txt")) {
-        fprintf(stderr, "Make sure SymbolTable.txt exists (run the lexer first).\n");
-        return 1;
+    fprintf(out, "\n=== Checking assignments ===\n");
+    if (check_log_used) fwrite(check_log, 1, check_log_used, out);
+    if (!ok) {
+        fprintf(stderr, "Out of memory building the symbol table\n");
+        return;
     }
 
-    printf("Loaded %d tokens from SymbolTable.txt\n\n", token_count);
+    fprintf(out, "\nDone.\n");
+}
+
+/* ---------------- main ---------------- */
 
-    printf("=== Building semantic symbol table ===\n");
-    build_symbol_table();
+#ifndef KSHARP_NO_MAIN
+int main(int argc, char **argv) {
+    int stats = 0;              /* --stats: report on stderr */
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--stats") == 0) {
+            stats = 1;
+        } else {
+            fprintf(stderr, "Unknown option: %s\nusage: semantic [--stats]\n", argv[a]);
+            return 1;
+        }
+    }
 
-    printf("\n=== Checking assignments ===\n");
-    check_assignments();
+    const char *source = KTOK_FILE;
+    double t = ksh_now();
+    if (!load_tokens_ktok(source)) {
+        source = "SymbolTable.txt";
+        if (!load_tokens(source)) {
+            fprintf(stderr, "Make sure %s or SymbolTable.txt exists (run the lexer first).\n",
+                    KTOK_FILE);
+            return 1;
+        }
+    }
+    ksh_stats_lap(&ksh_stats, KSH_PH_LOAD, t);
 
-    printf("\nDone.\n");
+    semantic_run(source);
+    if (stats) ksh_stats_print(stderr);
+    free_st_tokens();
     return 0;
 }
+#endif /* KSHARP_NO_MAIN */
@@ -0,0 +1,387 @@
+/* ksharp_server.c
+   The K# tools as a long-running server: K# source in, tokens, parse
+   results or semantic diagnostics out, without starting a process (and
+   opening files) for every snippet an editor or build tool asks about.
+
+   Usage:  ksharp_server [--no-tree] [--socket PATH]
+     without --socket  one client, on stdin/stdout
+     --socket PATH     listen on a Unix socket; each client gets a thread
+     --no-tree         PARSE replies without the XML tree
+
+   Protocol (the same on both): a request is one header line
+       COMMAND LENGTH [NAME]
+   followed by LENGTH bytes of K# source, and the reply is one line
+       OK LENGTH      or      ERR LENGTH
+   followed by LENGTH bytes. NAME is only used in the replies (the table
+   header, "Loaded ... from NAME"); it defaults to REQ_NAME.
+     LEX    the tokens as a .ktok stream (see ksharp_tokens.h)
+     TABLE  the tokens as SymbolTable.txt
+     PARSE  what the syntax analyzer prints: errors, tree and verdict
+     CHECK  what the semantic checker prints
+     QUIT   (LENGTH 0) no reply, the connection ends
+   A header that cannot be read ends the connection too: after it the
+   requests cannot be told apart any more.
+
+   Every connection keeps its source buffer, token records and table
+   buffer from one request to the next; the parser and the checker keep
+   their token arrays, tree pool and hash tables (reset, not freed). LEX
+   and TABLE of several clients run at the same time. PARSE and CHECK
+   go through the parser's and checker's global state, so they take
+   turns (g_tools). */
+
+#define KSHARP_NO_MAIN
+#if defined(__GNUC__)            /* the file loaders of each tool are unused here */
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "KSHARP2.0.C"
+#include "KSHARP_SYNTAX2.0.c"
+#include "ksharp_semantic.c"
+
+#ifndef KSH_HAVE_THREADS
+#error "ksharp_server needs POSIX threads and sockets"
+#endif
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define REQ_MAX   (256u * 1024 * 1024)    /* longest source accepted     */
+#define REQ_NAME  "request.ksh"           /* NAME when the header has none */
+
+static const ScanKernels *g_scan;         /* picked once, at start       */
+static pthread_mutex_t g_tools = PTHREAD_MUTEX_INITIALIZER;  /* parser + checker */
+
+/* ---------------- one client ---------------- */
+
+typedef struct {
+    FILE    *in, *out;       /* requests come in, replies go out */
+    char    *src;            /* source of the current request */
+    size_t   cap;            /* room in src */
+    KtokOut  K;              /* LEX: records and texts */
+    char    *table_buf;      /* TABLE: TABLE_BUF_SIZE bytes, made on first use */
+} Conn;
+
+static void conn_free(Conn *c) {
+    free(c->src);
+    ktok_out_free(&c->K);
+    free(c->table_buf);
+    c->src = c->table_buf = NULL;
+    c->cap = 0;
+}
+
+/* lexer_on:
+   A lexer over the first n bytes of the request. Lexemes are views into
+   c->src: every stage copies what it keeps. */
+static void lexer_on(Conn *c, Lexer *L, size_t n, int lazy_pos) {
+    memset(L, 0, sizeof *L);
+    L->buf = c->src;
+    L->len = n;
+    L->line = 1;
+    L->lazy_pos = lazy_pos;      /* PARSE and CHECK never look at line/col */
+    L->scan = g_scan;
+}
+
+/* ---------------- the requests ---------------- */
+
+/* run_lex:
+   LEX (table = 0) or TABLE (table = 1). Returns 0 if out of memory. */
+static int run_lex(Conn *c, size_t n, const char *name, int table, FILE *out) {
+    Lexer L;
+    TableOut T = {0};
+    int ok = 1;
+
+    lexer_on(c, &L, n, 0);
+    if (table) {
+        if (!c->table_buf && !(c->table_buf = (char *)malloc(TABLE_BUF_SIZE)))
+            return 0;
+        T.buf = c->table_buf;
+        T.sink[T.nsink++] = out;
+        write_head(&T, name);
+    }
+    c->K.nrec = c->K.nblob = 0;
+
+    for (;;) {
+        Token t = next_token(&L);
+        int k;
+        const char *text = token_text(&t, &k);
+        if (table) write_row(&T, text, k, tname(t.type));
+        else if (ok && !ktok_add(&c->K, &t, text, k)) ok = 0;
+        if (t.type == TOK_EOF) break;
+    }
+
+    if (table) write_foot(&T);
+    else if (ok) ok = ktok_write(&c->K, out);
+    return ok;
+}
+
+/* Token source for PARSE: like the pipeline's, but the texts are the
+   parser's own (g_names). */
+typedef struct {
+    Lexer *lex;
+    int    done;             /* EOF already handed out */
+    int    ok;               /* 0 once memory ran out */
+} Feed;
+
+static int feed_pull(void *ctx, ParserToken *out) {
+    Feed *F = (Feed *)ctx;
+    if (F->done) return 0;
+
+    Token t = next_token(F->lex);
+    if (t.type == TOK_EOF) {
+        F->done = 1;
+        set_eof(out);
+        return 1;
+    }
+    int n;
+    const char *text = token_text(&t, &n);
+    const char *lex = ksh_intern_str(&g_names, text, (size_t)n);
+    if (!lex) {
+        F->done = 1;
+        F->ok = 0;
+        return 0;
+    }
+    out->kind = map_type(t.type);
+    out->sym = t.sym;
+    out->lexeme = lex;
+    return 1;
+}
+
+/* The syntax errors go into the reply, before the tree. */
+static void reply_syntax_error(void *ctx, const char *msg, int tok) {
+    const char *near = g_tok_text[tok];
+    fprintf((FILE *)ctx, "[Syntax Error] %s. Near: %s\n",
+            msg, near[0] ? near : "(EOF)");
+}
+
+/* run_parse:
+   PARSE. Caller holds g_tools. Returns 0 if out of memory. */
+static int run_parse(Conn *c, size_t n, FILE *out) {
+    Lexer L;
+    Feed F = {0};
+    int rc = 2;
+
+    lexer_on(c, &L, n, 1);
+    F.lex = &L;
+    F.ok = 1;
+    ksh_intern_reset(&g_names);           /* texts of the last PARSE     */
+
+    g_out = out;
+    g_error_hook = reply_syntax_error;
+    g_error_ctx = out;
+    if (parser_set_source(feed_pull, &F))
+        rc = syntax_run();
+    g_out = NULL;
+    g_error_hook = NULL;
+    g_error_ctx = NULL;
+
+    line_index_free(&L);
+    return rc != 2 && F.ok;
+}
+
+/* run_check:
+   CHECK. Caller holds g_tools. Returns 0 if out of memory. */
+static int run_check(Conn *c, size_t n, const char *name, FILE *out) {
+    Lexer L;
+    int ok = 1;
+
+    lexer_on(c, &L, n, 1);
+    reset_st_tokens();
+    for (;;) {
+        Token t = next_token(&L);
+        if (t.type == TOK_EOF) break;
+        int k;
+        const char *text = token_text(&t, &k);
+        if (!add_token_copy(text, (size_t)k, t.type, t.sym)) {
+            ok = 0;
+            break;
+        }
+    }
+    line_index_free(&L);
+    if (!ok) return 0;
+
+    sem_out = out;
+    semantic_run(name);
+    sem_out = NULL;
+    return 1;
+}
+
+/* ---------------- the connection loop ---------------- */
+
+static int send_reply(FILE *out, const char *status, const char *body, size_t n) {
+    return fprintf(out, "%s %zu\n", status, n) > 0 &&
+           (n == 0 || fwrite(body, 1, n, out) == n) &&
+           fflush(out) == 0;
+}
+
+/* serve:
+   Answers requests until QUIT, end of input or a broken header. */
+static void serve(Conn *c) {
+    char line[1200];
+    char cmd[16], name[1024];
+    unsigned long long len;
+
+    while (fgets(line, sizeof line, c->in)) {
+        name[0] = '\0';
+        size_t ll = strlen(line);
+        if (ll == 0 || line[ll - 1] != '\n' ||
+            sscanf(line, "%15s %llu %1023s", cmd, &len, name) < 2) {
+            static const char msg[] = "bad request header\n";
+            send_reply(c->out, "ERR", msg, sizeof msg - 1);
+            return;
+        }
+        if (len > REQ_MAX) {
+            static const char msg[] = "request too long\n";
+            send_reply(c->out, "ERR", msg, sizeof msg - 1);
+            return;
+        }
+        if (!name[0]) memcpy(name, REQ_NAME, sizeof REQ_NAME);
+
+        size_t n = (size_t)len;
+        if (n > c->cap) {
+            char *p = (char *)realloc(c->src, n);
+            if (!p) {
+                static const char msg[] = "out of memory\n";
+                send_reply(c->out, "ERR", msg, sizeof msg - 1);
+                return;
+            }
+            c->src = p;
+            c->cap = n;
+        }
+        if (n && fread(c->src, 1, n, c->in) != n)
+            return;                       /* client went away           */
+        if (same_str(cmd, "QUIT"))
+            return;
+
+        char *body = NULL;
+        size_t body_len = 0;
+        FILE *out = open_memstream(&body, &body_len);
+        const char *err = out ? NULL : "out of memory\n";
+        if (out) {
+            int ok = 1;
+            if (same_str(cmd, "LEX")) ok = run_lex(c, n, name, 0, out);
+            else if (same_str(cmd, "TABLE")) ok = run_lex(c, n, name, 1, out);
+            else if (same_str(cmd, "PARSE") || same_str(cmd, "CHECK")) {
+                pthread_mutex_lock(&g_tools);
+                ok = cmd[0] == 'P' ? run_parse(c, n, out) : run_check(c, n, name, out);
+                pthread_mutex_unlock(&g_tools);
+            }
+            else err = "unknown command\n";
+            if (fclose(out) != 0 || !ok) err = "out of memory\n";
+        }
+
+        int sent = err ? send_reply(c->out, "ERR", err, strlen(err))
+                       : send_reply(c->out, "OK", body, body_len);
+        free(body);
+        if (!sent)
+            return;                       /* client went away           */
+    }
+}
+
+/* ---------------- Unix socket ---------------- */
+
+static void *client_main(void *arg) {
+    Conn *c = (Conn *)arg;
+    serve(c);
+    fclose(c->in);
+    fclose(c->out);
+    conn_free(c);
+    free(c);
+    return NULL;
+}
+
+/* listen_on:
+   Accepts clients on a Unix socket at path until accept() fails.
+   Returns 1 (and says why) if the socket cannot be set up. */
+static int listen_on(const char *path) {
+    struct sockaddr_un a;
+    size_t n = strlen(path);
+    if (n >= sizeof a.sun_path) {
+        fprintf(stderr, "Error: socket path too long: %s\n", path);
+        return 1;
+    }
+    memset(&a, 0, sizeof a);
+    a.sun_family = AF_UNIX;
+    memcpy(a.sun_path, path, n + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Error: cannot create socket\n");
+        return 1;
+    }
+    unlink(path);                         /* left over from a last run  */
+    if (bind(fd, (struct sockaddr *)&a, sizeof a) != 0 || listen(fd, 64) != 0) {
+        fprintf(stderr, "Error: cannot listen on %s\n", path);
+        close(fd);
+        return 1;
+    }
+
+    for (;;) {
+        int cfd = accept(fd, NULL, NULL);
+        if (cfd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            fprintf(stderr, "Error: accept failed on %s\n", path);
+            break;
+        }
+        Conn *c = (Conn *)calloc(1, sizeof(Conn));
+        int wfd = c ? dup(cfd) : -1;
+        if (c && wfd >= 0) {
+            c->in = fdopen(cfd, "rb");
+            c->out = fdopen(wfd, "wb");
+        }
+        pthread_t th;
+        if (!c || !c->in || !c->out ||
+            pthread_create(&th, NULL, client_main, c) != 0) {
+            fprintf(stderr, "Error: cannot take another client\n");
+            if (c && c->in) fclose(c->in); else close(cfd);
+            if (c && c->out) fclose(c->out); else if (wfd >= 0) close(wfd);
+            free(c);
+            continue;
+        }
+        pthread_detach(th);
+    }
+    close(fd);
+    unlink(path);
+    return 1;
+}
+
+/* ---------------- main ---------------- */
+
+int main(int argc, char **argv) {
+    const char *sock = NULL;
+
+    for (int a = 1; a < argc; a++) {
+        if (same_str(argv[a], "--socket")) {
+            if (a + 1 >= argc) {
+                fprintf(stderr, "Error: --socket needs a path\n");
+                return 1;
+            }
+            sock = argv[++a];
+        }
+        else if (tree_option(argv[a]) <= 0 ||
+                 (g_tree_format != TREE_XML && g_tree_format != TREE_NONE)) {
+            fprintf(stderr, "Error: unknown option: %s\n"
+                    "usage: ksharp_server [--no-tree] [--socket PATH]\n", argv[a]);
+            return 1;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);             /* a client hanging up is not fatal */
+    g_scan = select_kernels();
+
+    int status = 0;
+    if (sock) {
+        status = listen_on(sock);
+    } else {
+        Conn c;
+        memset(&c, 0, sizeof c);
+        c.in = stdin;
+        c.out = stdout;
+        serve(&c);
+        conn_free(&c);
+    }
+
+    free_st_tokens();            /* semantic tokens and their texts */
+    ast_free();                  /* syntax tree */
+    free_tokens();               /* parser tokens */
+    return status;
+}
@@ -0,0 +1,748 @@
+/* ksharp_tokens.h
+   Shared between the K# lexer, the syntax analyzer and the semantic
+   checker: the token kinds and the binary token stream (.ktok) that the
+   lexer hands to the other two tools.
+
+   .ktok layout (host byte order, the version field doubles as a check):
+     KtokHeader                      16 bytes
+     KtokRecord  x count             20 bytes each, in source order
+     blob                            blob_size bytes
+   Every record points at its text in the blob (off, len); the text is
+   exactly what the table shows in the Lexeme column, but never clipped,
+   and is followed by a '\0' so readers can use it in place.
+
+   Also here: KshPool, the string pool the syntax and semantic tools keep
+   token texts in when they are not views into a loaded .ktok file (the
+   parser also allocates its tree nodes from one), KshIntern, which keeps
+   each distinct text once under an id, the layout of the
+   binary syntax tree (.kast) the parser can write, and the counters
+   behind --stats. */
+
+#ifndef KSHARP_TOKENS_H
+#define KSHARP_TOKENS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/* ---------------- token type labels ----------------
+   This enum lists the possible "kinds" of tokens the lexer produces.
+   The values are stored in .ktok files: only add new kinds at the end. */
+typedef enum {
+    TOK_IDENTIFIER,       /* user names: myVar, count_1                  */
+    TOK_KEYWORD,          /* special words: if, while, return, ...       */
+    TOK_RESERVED_TYPE,    /* built-in types: int, float, char, bool, void */
+    TOK_CONST_INT,        /* number without dot: 123                     */
+    TOK_CONST_FLOAT,      /* number with dot: 12.34                      */
+    TOK_CONST_CHAR,       /* single char literal: 'a'                    */
+    TOK_CONST_BOOL,       /* true or false                               */
+    TOK_CONST_STRING,     /* "hello"                                     */
+    TOK_OP_ARITH,         /* + - * / % ** DIV MOD                        */
+    TOK_OP_REL,           /* < > <= >= == !=                             */
+    TOK_OP_LOGIC,         /* && || !                                     */
+    TOK_ASSIGN,           /* =                                           */
+    TOK_DELIM,            /* ; , : .                                     */
+    TOK_BRACKET,          /* () [] {}                                    */
+    TOK_COMMENT,          /* line or block comment                       */
+    TOK_NOISE,            /* words we treat as "noise": please, then, ... */
+    TOK_UNKNOWN,          /* anything not recognized or broken           */
+    TOK_EOF               /* end-of-file marker                          */
+} TokenType;
+
+#define TOK_KIND_COUNT (TOK_EOF + 1)
+
+/* ktok_type_name:
+   The label of a kind as printed in the Token column of SymbolTable.txt. */
+static inline const char *ktok_type_name(unsigned t) {
+    switch (t) {
+        case TOK_IDENTIFIER:    return "identifier";
+        case TOK_KEYWORD:       return "keyword";
+        case TOK_RESERVED_TYPE: return "type";
+        case TOK_CONST_INT:     return "const_int";
+        case TOK_CONST_FLOAT:   return "const_float";
+        case TOK_CONST_CHAR:    return "const_char";
+        case TOK_CONST_STRING:  return "const_string";
+        case TOK_CONST_BOOL:    return "const_bool";
+        case TOK_OP_ARITH:      return "operator";
+        case TOK_OP_REL:        return "operator";
+        case TOK_OP_LOGIC:      return "operator";
+        case TOK_ASSIGN:        return "operator";
+        case TOK_DELIM:         return "punctuator";
+        case TOK_BRACKET:       return "punctuator";
+        case TOK_COMMENT:       return "comment";
+        case TOK_NOISE:         return "noise";
+        case TOK_UNKNOWN:       return "unknown";
+        case TOK_EOF:           return "eof";
+    }
+    return "?";                   /* fallback, should not happen        */
+}
+
+/* ---------------- symbol ids ----------------
+   The exact punctuator, operator or keyword a token is, so the parser
+   can decide with an integer compare instead of looking at the text.
+   Tokens of any other kind (and keywords not spelled exactly, which the
+   lexer does not report as keywords) have KSYM_NONE. Stored in .ktok
+   files: only add new ids at the end. */
+typedef enum {
+    KSYM_NONE,
+    /* punctuators */
+    KSYM_SEMI, KSYM_COMMA, KSYM_COLON, KSYM_DOT,
+    KSYM_LPAREN, KSYM_RPAREN, KSYM_LBRACKET, KSYM_RBRACKET,
+    KSYM_LBRACE, KSYM_RBRACE,
+    /* operators (the six relational ones stay together, see ksym_is_rel) */
+    KSYM_ASSIGN,
+    KSYM_EQ, KSYM_NE, KSYM_LT, KSYM_LE, KSYM_GT, KSYM_GE,
+    KSYM_PLUS, KSYM_MINUS, KSYM_STAR, KSYM_SLASH, KSYM_PERCENT, KSYM_POW,
+    KSYM_DIV, KSYM_MOD,
+    KSYM_AND, KSYM_OR, KSYM_NOT,
+    /* keywords */
+    KSYM_IF, KSYM_ELSE, KSYM_ELSEIF, KSYM_WHILE, KSYM_FOR, KSYM_DO,
+    KSYM_REPEAT, KSYM_UNTIL, KSYM_SWITCH, KSYM_CASE, KSYM_DEFAULT,
+    KSYM_BREAK, KSYM_CONTINUE, KSYM_RETURN, KSYM_INPUT, KSYM_READLN,
+    KSYM_PRINT, KSYM_WRITELN, KSYM_BEGIN, KSYM_END, KSYM_THEN, KSYM_OF
+} KtokSym;
+
+#define KSYM_COUNT (KSYM_OF + 1)
+
+/* ksym_is_rel:
+   1 for == != < <= > >=. */
+static inline int ksym_is_rel(unsigned s) {
+    return s >= KSYM_EQ && s <= KSYM_GE;
+}
+
+/* ksym_name:
+   Spelling of a symbol id (lower case for the word operators), or ""
+   for KSYM_NONE. */
+static inline const char *ksym_name(unsigned s) {
+    switch (s) {
+        case KSYM_SEMI:     return ";";
+        case KSYM_COMMA:    return ",";
+        case KSYM_COLON:    return ":";
+        case KSYM_DOT:      return ".";
+        case KSYM_LPAREN:   return "(";
+        case KSYM_RPAREN:   return ")";
+        case KSYM_LBRACKET: return "[";
+        case KSYM_RBRACKET: return "]";
+        case KSYM_LBRACE:   return "{";
+        case KSYM_RBRACE:   return "}";
+        case KSYM_ASSIGN:   return "=";
+        case KSYM_EQ:       return "==";
+        case KSYM_NE:       return "!=";
+        case KSYM_LT:       return "<";
+        case KSYM_LE:       return "<=";
+        case KSYM_GT:       return ">";
+        case KSYM_GE:       return ">=";
+        case KSYM_PLUS:     return "+";
+        case KSYM_MINUS:    return "-";
+        case KSYM_STAR:     return "*";
+        case KSYM_SLASH:    return "/";
+        case KSYM_PERCENT:  return "%";
+        case KSYM_POW:      return "**";
+        case KSYM_DIV:      return "div";
+        case KSYM_MOD:      return "mod";
+        case KSYM_AND:      return "&&";
+        case KSYM_OR:       return "||";
+        case KSYM_NOT:      return "!";
+        case KSYM_IF:       return "if";
+        case KSYM_ELSE:     return "else";
+        case KSYM_ELSEIF:   return "elseif";
+        case KSYM_WHILE:    return "while";
+        case KSYM_FOR:      return "for";
+        case KSYM_DO:       return "do";
+        case KSYM_REPEAT:   return "repeat";
+        case KSYM_UNTIL:    return "until";
+        case KSYM_SWITCH:   return "switch";
+        case KSYM_CASE:     return "case";
+        case KSYM_DEFAULT:  return "default";
+        case KSYM_BREAK:    return "break";
+        case KSYM_CONTINUE: return "continue";
+        case KSYM_RETURN:   return "return";
+        case KSYM_INPUT:    return "input";
+        case KSYM_READLN:   return "readln";
+        case KSYM_PRINT:    return "print";
+        case KSYM_WRITELN:  return "writeln";
+        case KSYM_BEGIN:    return "begin";
+        case KSYM_END:      return "end";
+        case KSYM_THEN:     return "then";
+        case KSYM_OF:       return "of";
+    }
+    return "";
+}
+
+/* ksym_lookup:
+   Symbol id of a token text, for readers that only have the text (the
+   SymbolTable.txt fallback). Slow, a linear search; DIV and MOD match in
+   any case, as the lexer accepts them. Callers only ask for texts whose
+   kind is a punctuator, operator or keyword. */
+static inline unsigned ksym_lookup(const char *text) {
+    unsigned s;
+    for (s = 1; s < KSYM_COUNT; s++) {
+        const char *a = ksym_name(s), *b = text;
+        int fold = (s == KSYM_DIV || s == KSYM_MOD);
+        while (*a && (*a == *b || (fold && *a == (*b | 0x20)))) {
+            a++; b++;
+        }
+        if (*a == '\0' && *b == '\0')
+            return s;
+    }
+    return KSYM_NONE;
+}
+
+/* ---------------- --stats ----------------
+   Every tool keeps these counters and prints them (on stderr) with
+   --stats. They cost a clock read per phase, an addition per token and
+   one per allocation, so they are always on; build with -DKSH_NO_STATS
+   to compile the counting out. The memory counters only see the blocks
+   the tools grow themselves (arrays, pools, arenas, file buffers), which
+   is nearly all of it; threads update them atomically. */
+
+enum {
+    KSH_PH_LOAD,                  /* reading the input                  */
+    KSH_PH_LEX,                   /* next_token() loop                  */
+    KSH_PH_PARSE,                 /* parse_program()                    */
+    KSH_PH_SEMANTIC,              /* declarations and assignments       */
+    KSH_PH_WRITE,                 /* tables, token stream, tree         */
+    KSH_PH_COUNT
+};
+
+typedef struct {
+    double phase[KSH_PH_COUNT];   /* seconds                            */
+    size_t bytes;                 /* source bytes read                  */
+    size_t copied;                /* of those, read into memory by load */
+    size_t tokens[TOK_KIND_COUNT];/* tokens seen, by kind               */
+    size_t allocs;                /* malloc/realloc calls               */
+    size_t heap, heap_peak;       /* bytes in those blocks, now and max */
+    size_t nodes;                 /* syntax tree nodes made             */
+    size_t errors;                /* syntax errors reported             */
+    size_t recoveries;            /* panic_recover() calls              */
+} KshStats;
+
+static KshStats ksh_stats;
+
+#ifndef KSH_NO_STATS
+#define KSH_STAT(x) (x)
+#else
+#define KSH_STAT(x) ((void)0)
+#endif
+
+/* ksh_now:
+   Seconds on a clock that only goes forward. */
+static inline double ksh_now(void) {
+#if defined(__unix__) || defined(__APPLE__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;  /* CPU time: close enough */
+#endif
+}
+
+/* ksh_stats_lap:
+   Adds the time since t to phase ph of s. Returns the time now, where
+   the next phase starts. */
+static inline double ksh_stats_lap(KshStats *s, int ph, double t) {
+    double now = ksh_now();
+    s->phase[ph] += now - t;
+    return now;
+}
+
+/* ksh_stats_mem:
+   A block went from old_bytes to new_bytes (0 = not there); an
+   allocation when it grew. */
+static inline void ksh_stats_mem(size_t old_bytes, size_t new_bytes) {
+#ifndef KSH_NO_STATS
+#if defined(__GNUC__)
+    size_t now;
+    if (new_bytes > old_bytes) {
+        __atomic_add_fetch(&ksh_stats.allocs, 1, __ATOMIC_RELAXED);
+        now = __atomic_add_fetch(&ksh_stats.heap, new_bytes - old_bytes, __ATOMIC_RELAXED);
+    } else {
+        now = __atomic_sub_fetch(&ksh_stats.heap, old_bytes - new_bytes, __ATOMIC_RELAXED);
+    }
+    size_t peak = __atomic_load_n(&ksh_stats.heap_peak, __ATOMIC_RELAXED);
+    while (now > peak &&
+           !__atomic_compare_exchange_n(&ksh_stats.heap_peak, &peak, now, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+#else
+    if (new_bytes > old_bytes) ksh_stats.allocs++;
+    ksh_stats.heap += new_bytes - old_bytes;  /* wraps back when it shrinks */
+    if (ksh_stats.heap > ksh_stats.heap_peak) ksh_stats.heap_peak = ksh_stats.heap;
+#endif
+#else
+    (void)old_bytes;
+    (void)new_bytes;
+#endif
+}
+
+/* ksh_stats_add:
+   Adds the times, bytes and token counts of s (one thread's share) to
+   ksh_stats. */
+static inline void ksh_stats_add(const KshStats *s) {
+    for (int i = 0; i < KSH_PH_COUNT; i++) ksh_stats.phase[i] += s->phase[i];
+    for (int i = 0; i < TOK_KIND_COUNT; i++) ksh_stats.tokens[i] += s->tokens[i];
+    ksh_stats.bytes += s->bytes;
+    ksh_stats.copied += s->copied;
+}
+
+/* ksh_stats_print:
+   The --stats report of ksh_stats. Phases that did not run are left
+   out; "tokens/s" is all tokens over the phase's time. Load gets a MB/s
+   only when it read every byte: mmap() only sets up the mapping (the
+   pages come in during lex), and a stream is read while it is lexed. */
+static inline void ksh_stats_print(FILE *fp) {
+    static const char *const PHASE[KSH_PH_COUNT] = {
+        "load", "lex", "parse", "semantic", "write"
+    };
+    static const char *const KIND[TOK_KIND_COUNT] = {
+        "identifier", "keyword", "type", "const_int", "const_float",
+        "const_char", "const_bool", "const_string", "op_arith", "op_rel",
+        "op_logic", "assign", "delim", "bracket", "comment", "noise",
+        "unknown", "eof"
+    };
+    size_t tokens = 0;
+    double total = 0;
+    for (int i = 0; i < TOK_KIND_COUNT; i++) tokens += ksh_stats.tokens[i];
+
+    for (int i = 0; i < KSH_PH_COUNT; i++) {
+        double t = ksh_stats.phase[i];
+        if (t <= 0) continue;
+        total += t;
+        fprintf(fp, "[Stats] %-10s %10.6f s", PHASE[i], t);
+        if (ksh_stats.bytes && (i == KSH_PH_LEX ||
+                                (i == KSH_PH_LOAD && ksh_stats.copied == ksh_stats.bytes)))
+            fprintf(fp, "  %9.1f MB/s", (double)ksh_stats.bytes / 1e6 / t);
+        if (i != KSH_PH_LOAD && i != KSH_PH_WRITE && tokens)
+            fprintf(fp, "  %12.0f tokens/s", (double)tokens / t);
+        fputc('\n', fp);
+    }
+    fprintf(fp, "[Stats] %-10s %10.6f s\n", "total", total);
+    if (ksh_stats.bytes)          /* not known when reading a token file */
+        fprintf(fp, "[Stats] %-10s %10zu bytes\n", "source", ksh_stats.bytes);
+    fprintf(fp, "[Stats] %-10s %10zu\n", "tokens", tokens);
+    for (int i = 0; i < TOK_KIND_COUNT; i++)
+        if (ksh_stats.tokens[i])
+            fprintf(fp, "[Stats]   %-12s %10zu\n", KIND[i], ksh_stats.tokens[i]);
+    fprintf(fp, "[Stats] %-10s %10zu bytes peak, %zu allocations\n", "heap",
+            ksh_stats.heap_peak, ksh_stats.allocs);
+    if (ksh_stats.nodes || ksh_stats.errors || ksh_stats.recoveries)
+        fprintf(fp, "[Stats] %-10s %10zu nodes, %zu syntax errors, %zu recoveries\n",
+                "parser", ksh_stats.nodes, ksh_stats.errors, ksh_stats.recoveries);
+}
+
+/* ---------------- binary token stream (.ktok) ---------------- */
+
+#define KTOK_FILE    "SymbolTable.ktok"
+#define KTOK_VERSION 2u               /* 2: records carry the symbol id   */
+
+#define KTOK_F_LABEL 0x01u        /* text is a label, not source bytes  */
+
+typedef struct {
+    char     magic[4];            /* 'K' 'T' 'O' 'K'                    */
+    uint32_t version;             /* KTOK_VERSION                       */
+    uint32_t count;               /* number of records                  */
+    uint32_t blob_size;           /* bytes of text after the records    */
+} KtokHeader;
+
+typedef struct {
+    uint8_t  type;                /* TokenType                          */
+    uint8_t  flags;               /* KTOK_F_*                           */
+    uint16_t sym;                 /* KtokSym, KSYM_NONE if not a symbol */
+    uint32_t line, col;           /* position reported by the lexer     */
+    uint32_t off, len;            /* text = blob + off, len bytes       */
+} KtokRecord;
+
+/* KtokFile:
+   A loaded .ktok file. Everything lives in one buffer (mem). */
+typedef struct {
+    void             *mem;        /* whole file as read                 */
+    const KtokRecord *rec;        /* count records                      */
+    const char       *blob;       /* token texts                        */
+    uint32_t          count;
+} KtokFile;
+
+/* ktok_text:
+   Null-terminated text of record i. */
+static inline const char *ktok_text(const KtokFile *f, uint32_t i) {
+    return f->blob + f->rec[i].off;
+}
+
+/* ktok_free:
+   Release a file filled by ktok_load. */
+static inline void ktok_free(KtokFile *f) {
+    free(f->mem);
+    f->mem = NULL; f->rec = NULL; f->blob = NULL; f->count = 0;
+}
+
+/* ktok_view:
+   Check the .ktok image mem[0..size) and point f into it. f->mem stays
+   NULL: the image is the caller's and must outlive f.
+   Returns 1 if it is a valid .ktok image, -1 if not (wrong magic or
+   version, truncated, bad offsets). */
+static inline int ktok_view(const void *mem, size_t size, KtokFile *f) {
+    const KtokHeader *h = (const KtokHeader *)mem;
+    const char *base = (const char *)mem;
+    uint32_t i;
+
+    f->mem = NULL; f->rec = NULL; f->blob = NULL; f->count = 0;
+
+    /* header: magic, version and total size must all agree           */
+    if (size < sizeof(KtokHeader) ||
+        h->magic[0] != 'K' || h->magic[1] != 'T' ||
+        h->magic[2] != 'O' || h->magic[3] != 'K' ||
+        h->version != KTOK_VERSION ||
+        (uint64_t)size != sizeof(KtokHeader) +
+                          (uint64_t)h->count * sizeof(KtokRecord) +
+                          h->blob_size)
+        return -1;
+
+    f->rec   = (const KtokRecord *)(base + sizeof(KtokHeader));
+    f->blob  = base + sizeof(KtokHeader) + (size_t)h->count * sizeof(KtokRecord);
+    f->count = h->count;
+
+    /* every text must lie inside the blob and end with '\0'          */
+    for (i = 0; i < f->count; i++) {
+        const KtokRecord *r = &f->rec[i];
+        if ((uint64_t)r->off + r->len >= h->blob_size ||
+            f->blob[r->off + r->len] != '\0') {
+            f->rec = NULL; f->blob = NULL; f->count = 0;
+            return -1;
+        }
+    }
+    return 1;
+}
+
+/* ktok_load:
+   Read a whole .ktok file with one fread and check it.
+   Returns 1 on success, 0 if the file cannot be opened, -1 if it is not
+   a valid .ktok file (see ktok_view). */
+static inline int ktok_load(const char *path, KtokFile *f) {
+    FILE *fp = fopen(path, "rb");
+    long size;
+    char *mem;
+
+    f->mem = NULL; f->rec = NULL; f->blob = NULL; f->count = 0;
+    if (!fp)
+        return 0;
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 0 ||
+        fseek(fp, 0, SEEK_SET) != 0) {
+        fclose(fp);
+        return -1;
+    }
+    mem = (char *)malloc(size ? (size_t)size : 1);
+    if (!mem) {
+        fclose(fp);
+        return -1;
+    }
+    ksh_stats_mem(0, (size_t)size);
+    if (fread(mem, 1, (size_t)size, fp) != (size_t)size) {
+        free(mem);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    if (ktok_view(mem, (size_t)size, f) != 1) {
+        free(mem);
+        return -1;
+    }
+    f->mem = mem;
+    return 1;
+}
+
+/* ---------------- binary syntax tree (.kast) ----------------
+   Written by the syntax analyzer with --tree=bin, for tools that want
+   the parse tree without parsing XML:
+     KastHeader                      16 bytes
+     KastNode    x count             16 bytes each, in preorder
+     blob                            blob_size bytes
+   A node's children follow it directly (nchild of them, each with its
+   own subtree). Leaves have their token text in the blob (off, len,
+   '\0'-terminated); other nodes have off = len = 0. The kind values
+   are the parser's AstKind, tag names as in the XML output. */
+
+#define KAST_FILE    "SyntaxTree.kast"
+#define KAST_VERSION 1u
+
+typedef struct {
+    char     magic[4];            /* 'K' 'A' 'S' 'T'                    */
+    uint32_t version;             /* KAST_VERSION                       */
+    uint32_t count;               /* number of nodes                    */
+    uint32_t blob_size;           /* bytes of text after the nodes      */
+} KastHeader;
+
+typedef struct {
+    uint8_t  kind;                /* AstKind                            */
+    uint8_t  sym;                 /* KtokSym of a leaf's token, or 0    */
+    uint16_t reserved;            /* 0                                  */
+    uint32_t nchild;              /* direct children                    */
+    uint32_t off, len;            /* leaf text = blob + off, len bytes  */
+} KastNode;
+
+/* ---------------- string pool ----------------
+   Texts (and other small objects, see ksh_pool_alloc) are copied once
+   into big blocks that never move, so a token can keep a plain pointer
+   to its text. Everything is freed (or, see ksh_pool_reset, emptied)
+   at once. */
+
+#define KSH_POOL_BLOCK (64 * 1024)  /* bytes per block (more for big items) */
+#define KSH_POOL_ALIGN 8            /* alignment of ksh_pool_alloc results */
+
+typedef struct KshPoolBlock {
+    struct KshPoolBlock *next;      /* older block                        */
+    size_t used, cap;               /* bytes after the header (24 bytes, so
+                                       the data is 8-byte aligned)        */
+} KshPoolBlock;
+
+typedef struct {
+    KshPoolBlock *head;             /* block being filled                 */
+} KshPool;
+
+/* ksh_pool_take:
+   n bytes at a multiple of align (a power of two) in the current block,
+   or in a new one. NULL if out of memory. */
+static inline void *ksh_pool_take(KshPool *p, size_t n, size_t align) {
+    KshPoolBlock *b = p->head;
+    size_t at = b ? (b->used + align - 1) & ~(align - 1) : 0;
+    if (!b || at > b->cap || b->cap - at < n) {
+        size_t cap = n > KSH_POOL_BLOCK ? n : KSH_POOL_BLOCK;
+        b = (KshPoolBlock *)malloc(sizeof(KshPoolBlock) + cap);
+        if (!b)
+            return NULL;
+        ksh_stats_mem(0, sizeof(KshPoolBlock) + cap);
+        b->next = p->head; b->used = 0; b->cap = cap;
+        p->head = b;
+        at = 0;
+    }
+    b->used = at + n;
+    return (char *)(b + 1) + at;
+}
+
+/* ksh_pool_alloc:
+   Uninitialized, aligned room for one object of n bytes. */
+static inline void *ksh_pool_alloc(KshPool *p, size_t n) {
+    return ksh_pool_take(p, n, KSH_POOL_ALIGN);
+}
+
+/* ksh_pool_strn:
+   Copy s[0..n) plus a '\0' into the pool. NULL if out of memory. */
+static inline const char *ksh_pool_strn(KshPool *p, const char *s, size_t n) {
+    char *d = (char *)ksh_pool_take(p, n + 1, 1);
+    if (!d)
+        return NULL;
+    memcpy(d, s, n);
+    d[n] = '\0';
+    return d;
+}
+
+/* ksh_pool_free:
+   Release every block; all texts from this pool become invalid. */
+static inline void ksh_pool_free(KshPool *p) {
+    while (p->head) {
+        KshPoolBlock *b = p->head;
+        p->head = b->next;
+        ksh_stats_mem(sizeof(KshPoolBlock) + b->cap, 0);
+        free(b);
+    }
+}
+
+/* ksh_pool_reset:
+   Like ksh_pool_free, but keeps the newest block for the next round (a
+   program that fills the pool again and again, see ksharp_server.c,
+   then mostly stays inside it). */
+static inline void ksh_pool_reset(KshPool *p) {
+    KshPoolBlock *b = p->head;
+    if (!b)
+        return;
+    p->head = b->next;
+    ksh_pool_free(p);
+    b->next = NULL;
+    b->used = 0;
+    p->head = b;
+}
+
+/* ---------------- interned texts ----------------
+   Every distinct text once, under a small stable id (0, 1, 2, ... in
+   the order first seen): repeated identifiers and literals cost one
+   copy, and two texts are the same exactly when their ids are. A text
+   is copied into the pool the first time it is seen (ksh_intern), or
+   kept where it is when it outlives the table (ksh_intern_view). The
+   value of a string or char literal, with its escapes decoded, is only
+   made when ksh_intern_value asks for it, once per id. */
+
+typedef struct {
+    const char *text;               /* '\0'-terminated                    */
+    const char *value;              /* decoded literal, NULL until asked  */
+    uint32_t len, vlen;             /* bytes in text / in value           */
+    uint32_t hash;
+} KshName;
+
+typedef struct {
+    KshPool  pool;                  /* copied texts and decoded values    */
+    KshName *names;                 /* id -> name                         */
+    int32_t *slots;                 /* open addressing: id, or -1         */
+    int count, cap;                 /* ids in use / room in names         */
+    int nslots;                     /* a power of two, or 0               */
+} KshIntern;
+
+/* ksh_unescape:
+   The value of a literal body s[0..n) as the lexer keeps it (escapes
+   not decoded) into out, which needs n bytes; returns its length.
+   \n \t \r \0 are control bytes, any other \c is c itself. */
+static inline size_t ksh_unescape(const char *s, size_t n, char *out) {
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        char c = s[i];
+        if (c == '\\' && i + 1 < n) {
+            c = s[++i];
+            if (c == 'n') c = '\n';
+            else if (c == 't') c = '\t';
+            else if (c == 'r') c = '\r';
+            else if (c == '0') c = '\0';
+        }
+        out[k++] = c;
+    }
+    return k;
+}
+
+static inline uint32_t ksh_intern_hash(const char *s, size_t n) {
+    uint32_t h = 2166136261u;       /* FNV-1a */
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* ksh_intern_grow:
+   Room for one more id, and a table at most half full. Returns 0 if out
+   of memory (nothing changed then). */
+static inline int ksh_intern_grow(KshIntern *I) {
+    if (I->count == I->cap) {
+        int cap = I->cap ? I->cap * 2 : 1024;
+        KshName *p = (KshName *)realloc(I->names, (size_t)cap * sizeof(KshName));
+        if (!p)
+            return 0;
+        ksh_stats_mem((size_t)I->cap * sizeof(KshName), (size_t)cap * sizeof(KshName));
+        I->names = p;
+        I->cap = cap;
+    }
+    if (I->count * 2 >= I->nslots) {
+        int ns = I->nslots ? I->nslots * 2 : 2048;
+        int32_t *t = (int32_t *)malloc((size_t)ns * sizeof(int32_t));
+        if (!t)
+            return 0;
+        ksh_stats_mem((size_t)I->nslots * sizeof(int32_t), (size_t)ns * sizeof(int32_t));
+        memset(t, 0xff, (size_t)ns * sizeof(int32_t));
+        for (int id = 0; id < I->count; id++) {
+            uint32_t j = I->names[id].hash & (uint32_t)(ns - 1);
+            while (t[j] >= 0) j = (j + 1) & (uint32_t)(ns - 1);
+            t[j] = id;
+        }
+        free(I->slots);
+        I->slots = t;
+        I->nslots = ns;
+    }
+    return 1;
+}
+
+/* ksh_intern_add:
+   The id of s[0..n), a new one the first time; copy says whether a new
+   text goes into the pool or stays at s. -1 if out of memory. */
+static inline int ksh_intern_add(KshIntern *I, const char *s, size_t n, int copy) {
+    if (n > UINT32_MAX || !ksh_intern_grow(I))
+        return -1;
+    uint32_t h = ksh_intern_hash(s, n);
+    uint32_t j = h & (uint32_t)(I->nslots - 1);
+    for (int32_t id; (id = I->slots[j]) >= 0; j = (j + 1) & (uint32_t)(I->nslots - 1)) {
+        const KshName *e = &I->names[id];
+        if (e->hash == h && e->len == n && memcmp(e->text, s, n) == 0)
+            return id;
+    }
+    const char *text = copy ? ksh_pool_strn(&I->pool, s, n) : s;
+    if (!text)
+        return -1;
+    KshName *e = &I->names[I->count];
+    e->text = text;
+    e->value = NULL;
+    e->len = (uint32_t)n;
+    e->vlen = 0;
+    e->hash = h;
+    I->slots[j] = I->count;
+    return I->count++;
+}
+
+/* ksh_intern:
+   The id of s[0..n); the first time, s is copied. -1 if out of memory. */
+static inline int ksh_intern(KshIntern *I, const char *s, size_t n) {
+    return ksh_intern_add(I, s, n, 1);
+}
+
+/* ksh_intern_view:
+   Like ksh_intern, but a new text is used in place: s[n] must be '\0'
+   and s must stay valid as long as the table. */
+static inline int ksh_intern_view(KshIntern *I, const char *s, size_t n) {
+    return ksh_intern_add(I, s, n, 0);
+}
+
+/* ksh_intern_str:
+   The one copy of s[0..n) ('\0'-terminated), or NULL if out of memory. */
+static inline const char *ksh_intern_str(KshIntern *I, const char *s, size_t n) {
+    int id = ksh_intern(I, s, n);
+    return id < 0 ? NULL : I->names[id].text;
+}
+
+/* ksh_intern_text:
+   The text of id, '\0'-terminated; *n gets its length unless n is NULL. */
+static inline const char *ksh_intern_text(const KshIntern *I, int id, size_t *n) {
+    if (n)
+        *n = I->names[id].len;
+    return I->names[id].text;
+}
+
+/* ksh_intern_value:
+   The text of id read as a string or char literal body, with its escapes
+   decoded (see ksh_unescape); *n gets its length. Made on the first call
+   and kept. NULL if out of memory. */
+static inline const char *ksh_intern_value(KshIntern *I, int id, size_t *n) {
+    KshName *e = &I->names[id];
+    if (!e->value) {
+        if (!memchr(e->text, '\\', e->len)) {
+            e->value = e->text;     /* nothing to decode */
+            e->vlen = e->len;
+        } else {
+            char *v = (char *)ksh_pool_take(&I->pool, e->len, 1);
+            if (!v)
+                return NULL;
+            e->vlen = (uint32_t)ksh_unescape(e->text, e->len, v);
+            e->value = v;
+        }
+    }
+    *n = e->vlen;
+    return e->value;
+}
+
+/* ksh_intern_reset:
+   Forget every id but keep the memory, for the next text. */
+static inline void ksh_intern_reset(KshIntern *I) {
+    ksh_pool_reset(&I->pool);
+    if (I->slots)
+        memset(I->slots, 0xff, (size_t)I->nslots * sizeof(int32_t));
+    I->count = 0;
+}
+
+/* ksh_intern_free:
+   Release everything; the texts it copied become invalid. */
+static inline void ksh_intern_free(KshIntern *I) {
+    ksh_pool_free(&I->pool);
+    ksh_stats_mem((size_t)I->cap * sizeof(KshName) + (size_t)I->nslots * sizeof(int32_t), 0);
+    free(I->names);
+    free(I->slots);
+    I->names = NULL;
+    I->slots = NULL;
+    I->count = I->cap = I->nslots = 0;
+}
+
+#endif /* KSHARP_TOKENS_H */
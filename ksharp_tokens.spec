@@ -0,0 +1,142 @@
+# ksharp_tokens.spec
+# The tokens of K#. ksharp_dfagen turns this file into ksharp_dfa.h: one
+# minimized DFA, coded as goto states (scan_token), that next_token()
+# runs for every token. A new keyword, operator or literal form is a
+# line here; make -f MakeFile regenerates the DFA.
+#
+#   name = pattern                   a named pattern, for the lines below
+#   %kernel find_x [set]             a scan kernel of ScanKernels, which
+#                                    skips the bytes of [set]; a state that
+#                                    loops on exactly [set] calls it
+#   pattern => TYPE [KSYM_x] [what]  a token of kind TYPE (and symbol id)
+#
+# Patterns: "text" (exact), 'text' (letters in any case), [a-z_] and
+# [^...] byte sets, any (one byte), a name, ( ), |, * + ?. In texts and
+# sets \n \t \r \0 and \xHH are those bytes, and a backslash before
+# \ " ' [ ] - or ^ takes it as it is.
+#
+# The longest match wins; of two rules that match the same bytes, the
+# first one. The token's text is the bytes it matched, unless what says
+#   body          without their first and last byte (the quotes)
+#   label "text"  the static label text instead
+#   sym           its own text (the pattern is one "text") as the label
+#   extra "text"  the bytes, with the label text for the table
+#   limit NAME    at most NAME bytes: a longer match is cut there
+# Whitespace never gets here: next_token() skips it first.
+
+digit  = [0-9]
+letter = [A-Za-z_]
+word   = [A-Za-z_0-9]
+
+%kernel find_str_stop  [^"\\\n]
+%kernel find_newline   [^\n]
+%kernel find_star      [^*]
+
+# ---- keywords: spelled exactly ----
+"if"        => TOK_KEYWORD  KSYM_IF
+"else"      => TOK_KEYWORD  KSYM_ELSE
+"elseif"    => TOK_KEYWORD  KSYM_ELSEIF
+"for"       => TOK_KEYWORD  KSYM_FOR
+"while"     => TOK_KEYWORD  KSYM_WHILE
+"do"        => TOK_KEYWORD  KSYM_DO
+"switch"    => TOK_KEYWORD  KSYM_SWITCH
+"case"      => TOK_KEYWORD  KSYM_CASE
+"default"   => TOK_KEYWORD  KSYM_DEFAULT
+"break"     => TOK_KEYWORD  KSYM_BREAK
+"continue"  => TOK_KEYWORD  KSYM_CONTINUE
+"return"    => TOK_KEYWORD  KSYM_RETURN
+"print"     => TOK_KEYWORD  KSYM_PRINT
+"input"     => TOK_KEYWORD  KSYM_INPUT
+"writeln"   => TOK_KEYWORD  KSYM_WRITELN
+"readln"    => TOK_KEYWORD  KSYM_READLN
+"begin"     => TOK_KEYWORD  KSYM_BEGIN
+"end"       => TOK_KEYWORD  KSYM_END
+"then"      => TOK_KEYWORD  KSYM_THEN
+"of"        => TOK_KEYWORD  KSYM_OF
+"repeat"    => TOK_KEYWORD  KSYM_REPEAT
+"until"     => TOK_KEYWORD  KSYM_UNTIL
+
+# the keywords that are also noise words are noise with a capital first
+# letter; the other keywords spelled that way are plain identifiers
+"Do"        => TOK_NOISE
+"Begin"     => TOK_NOISE
+"End"       => TOK_NOISE
+"Then"      => TOK_NOISE
+"Of"        => TOK_NOISE
+
+# ---- noise words, types, true/false: the first letter may be a capital ----
+[pP] "lease" => TOK_NOISE
+[aA] "nd"    => TOK_NOISE
+[tT] "o"     => TOK_NOISE
+[fF] "rom"   => TOK_NOISE
+[iI] "nt"    => TOK_RESERVED_TYPE
+[fF] "loat"  => TOK_RESERVED_TYPE
+[cC] "har"   => TOK_RESERVED_TYPE
+[bB] "ool"   => TOK_RESERVED_TYPE
+[vV] "oid"   => TOK_RESERVED_TYPE
+[tT] "rue"   => TOK_CONST_BOOL
+[fF] "alse"  => TOK_CONST_BOOL
+
+# ---- word operators: any case ----
+'div'  => TOK_OP_ARITH  KSYM_DIV  extra "DIV"
+'mod'  => TOK_OP_ARITH  KSYM_MOD  extra "MOD"
+
+letter word*  => TOK_IDENTIFIER
+
+# ---- literals ----
+digit+             => TOK_CONST_INT
+digit+ "." digit+  => TOK_CONST_FLOAT
+digit+ "."         => TOK_UNKNOWN  label "<bad_float>"
+
+# a string ends at its closing quote; a backslash takes the next byte as
+# it is, even a newline. A raw newline (or the end) first: broken string,
+# which stops before the newline
+"\"" ([^"\\\n] | "\\" any)* "\""   => TOK_CONST_STRING  body
+"\"" ([^"\\\n] | "\\" any)* "\\"?  => TOK_UNKNOWN  label "<unterminated_string>"
+
+# any one byte (a newline too) or a backslash and any byte; a broken char
+# takes the quote and the one (or escaped) byte after it
+"'" ([^\\] | "\\" any) "'"  => TOK_CONST_CHAR  body
+"'" ([^\\] | "\\" any?)?    => TOK_UNKNOWN  label "<unterminated_char>"
+
+# ---- comments ----
+"//" [^\n]*                         => TOK_COMMENT  label "//"
+"/*" ([^*] | "*"+ [^*/])* "*"+ "/"  => TOK_COMMENT  label "/* */"
+"/*" ([^*] | "*"+ [^*/])* "*"*      => TOK_UNKNOWN  label "<unterminated_comment>"
+
+# ---- operators ----
+"=="  => TOK_OP_REL    KSYM_EQ       sym
+"!="  => TOK_OP_REL    KSYM_NE       sym
+"<="  => TOK_OP_REL    KSYM_LE       sym
+">="  => TOK_OP_REL    KSYM_GE       sym
+"<"   => TOK_OP_REL    KSYM_LT       sym
+">"   => TOK_OP_REL    KSYM_GT       sym
+"&&"  => TOK_OP_LOGIC  KSYM_AND      sym
+"||"  => TOK_OP_LOGIC  KSYM_OR       sym
+"!"   => TOK_OP_LOGIC  KSYM_NOT      sym
+"**"  => TOK_OP_ARITH  KSYM_POW      sym
+"+"   => TOK_OP_ARITH  KSYM_PLUS     sym
+"-"   => TOK_OP_ARITH  KSYM_MINUS    sym
+"*"   => TOK_OP_ARITH  KSYM_STAR     sym
+"/"   => TOK_OP_ARITH  KSYM_SLASH    sym
+"%"   => TOK_OP_ARITH  KSYM_PERCENT  sym
+"="   => TOK_ASSIGN    KSYM_ASSIGN   sym
+
+# ---- delimiters and brackets ----
+";"   => TOK_DELIM    KSYM_SEMI      sym
+","   => TOK_DELIM    KSYM_COMMA     sym
+":"   => TOK_DELIM    KSYM_COLON     sym
+"."   => TOK_DELIM    KSYM_DOT       sym
+"("   => TOK_BRACKET  KSYM_LPAREN    sym
+")"   => TOK_BRACKET  KSYM_RPAREN    sym
+"["   => TOK_BRACKET  KSYM_LBRACKET  sym
+"]"   => TOK_BRACKET  KSYM_RBRACKET  sym
+"{"   => TOK_BRACKET  KSYM_LBRACE    sym
+"}"   => TOK_BRACKET  KSYM_RBRACE    sym
+
+# ---- everything else ----
+# bytes that start no token: a run of them is one token, so binary junk
+# gives one row (and one parser error) per run, not per byte
+[^ \t\r\n A-Za-z_0-9;,:.()\[\]{}*+\-%=<>!&|/"']+  => TOK_UNKNOWN  limit UNKNOWN_RUN_MAX
+# a lone & or |
+any  => TOK_UNKNOWN